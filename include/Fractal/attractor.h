@@ -0,0 +1,85 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+#ifndef _ATTRACTOR_H_
+#define _ATTRACTOR_H_
+
+// Libraries being used
+#include <complex>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * The number of iterations the critical orbit is given to settle
+	 * onto the attracting cycle
+	 */
+	const unsigned ATTRACTOR_SETTLE = 4096;
+
+	/**
+	 * The longest attracting cycle that is searched for
+	 */
+	const unsigned ATTRACTOR_PERIOD = 64;
+
+	/**
+	 * An attracting cycle of z = z^2 + c and a disk around one of its points
+	 * that lies inside its basin
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct Attractor
+	{
+		/**
+		 * A point of the cycle
+		 */
+		std::complex<double> point;
+
+		/**
+		 * The number of points in the cycle
+		 */
+		unsigned period;
+
+		/**
+		 * The multiplier of the cycle (less than one in magnitude)
+		 */
+		std::complex<double> multiplier;
+
+		/**
+		 * The radius of the disk around the point that is captured by the cycle
+		 */
+		double radius;
+
+		/**
+		 * Creates an empty Attractor
+		 */
+		Attractor();
+	};
+
+	/**
+	 * Finds the attracting cycle of z = z^2 + c, if any. The critical orbit
+	 * (starting at zero) is drawn into every attracting cycle, so it is iterated
+	 * until it settles, its period is found and refined with Newton's method,
+	 * and the disk around the cycle point is shrunk until points on its rim
+	 * land well inside it after one period.
+	 *
+	 * @param c         the julia set complex constant
+	 * @param attractor the attracting cycle (set if one is found)
+	 *
+	 * @return true if z = z^2 + c has an attracting cycle
+	 */
+	bool findAttractor(const std::complex<double>& c, Attractor& attractor);
+}
+
+#endif
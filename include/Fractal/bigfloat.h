@@ -0,0 +1,149 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+#ifndef _BIGFLOAT_H_
+#define _BIGFLOAT_H_
+
+// Libraries being used
+#include <string>
+#include <vector>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * A fixed-point number of any precision, made of 32-bit limbs. The first
+	 * limb is the integer part and each following limb holds the next 32 bits
+	 * after the point, so it only holds numbers below 2^32 in magnitude (which
+	 * is all a reference orbit needs). Numbers of different precisions must
+	 * not be mixed.
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	class BigFloat
+	{
+	private:
+		/**
+		 * True if the number is negative
+		 */
+		bool m_negative;
+
+		/**
+		 * The magnitude of the number, most significant limb first
+		 */
+		std::vector<unsigned> m_limbs;
+
+		/**
+		 * Returns true if the magnitude of this number is less than that of the other
+		 *
+		 * @param other the other number
+		 *
+		 * @return true if the magnitude of this number is less than that of the other
+		 */
+		bool lessMagnitude(const BigFloat& other) const;
+
+		/**
+		 * Adds the magnitude of the other number to the magnitude of this number
+		 *
+		 * @param other the other number
+		 */
+		void addMagnitude(const BigFloat& other);
+
+		/**
+		 * Subtracts the magnitude of the other number from the magnitude of this
+		 * number (which must be at least as large)
+		 *
+		 * @param other the other number
+		 */
+		void subMagnitude(const BigFloat& other);
+	public:
+		/**
+		 * Creates a zero BigFloat with the given number of limbs
+		 *
+		 * @param limbs the number of limbs (one integer limb and the fraction)
+		 */
+		BigFloat(unsigned limbs = 2);
+
+		/**
+		 * Creates a BigFloat with the given number of limbs equal to the given double
+		 *
+		 * @param x     the double
+		 * @param limbs the number of limbs (one integer limb and the fraction)
+		 */
+		BigFloat(double x, unsigned limbs);
+
+		/**
+		 * Creates a BigFloat with the given number of limbs from the given decimal
+		 * string (such as "-0.75", "1e-20" or a 100 digit offset)
+		 *
+		 * @param str   the decimal string
+		 * @param limbs the number of limbs (one integer limb and the fraction)
+		 */
+		BigFloat(const std::string& str, unsigned limbs);
+
+		/**
+		 * Returns the number rounded to a double
+		 *
+		 * @return the number rounded to a double
+		 */
+		double toDouble() const;
+
+		/**
+		 * Divides this number by the given small integer
+		 *
+		 * @param divisor the divisor
+		 */
+		void divide(unsigned divisor);
+
+		/**
+		 * Returns the sum of this number and the other
+		 *
+		 * @param other the other number
+		 *
+		 * @return the sum of this number and the other
+		 */
+		BigFloat operator+(const BigFloat& other) const;
+
+		/**
+		 * Returns the difference of this number and the other
+		 *
+		 * @param other the other number
+		 *
+		 * @return the difference of this number and the other
+		 */
+		BigFloat operator-(const BigFloat& other) const;
+
+		/**
+		 * Returns the product of this number and the other (truncated to the
+		 * precision of this number)
+		 *
+		 * @param other the other number
+		 *
+		 * @return the product of this number and the other
+		 */
+		BigFloat operator*(const BigFloat& other) const;
+	};
+
+	/**
+	 * Returns the number of limbs a BigFloat needs to resolve the given distance
+	 *
+	 * @param spacing the smallest distance that must be resolved
+	 *
+	 * @return the number of limbs needed
+	 */
+	unsigned bigFloatLimbs(double spacing);
+}
+
+#endif
@@ -31,7 +31,7 @@ namespace fractal
 	{
 		/**
 		 * Represents a linear gradient between two 
-		 * end colors over a space of 256 units
+		 * end colors over a space of one unit
 		 *
 		 * @author  Anshul Kharbanda
 		 * @created 8 - 16 - 2016
@@ -92,7 +92,7 @@ namespace fractal
 
 		/**
 		 * Represents a linear gradient between two 
-		 * end colors over a space of 256 units
+		 * end colors over a space of one unit
 		 *
 		 * @author  Anshul Kharbanda
 		 * @created 8 - 16 - 2016
@@ -139,9 +139,9 @@ namespace fractal
 			/**
 			 * Computes the gradient value at the given point in the space
 			 *
-			 * @param point the point in the gradient space
+			 * @param point the point in the gradient space (0 to 1)
 			 */
-			ColorGradientRGB operator*(unsigned point) const;
+			ColorGradientRGB operator*(double point) const;
 		};
 	}
 }
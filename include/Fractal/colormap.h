@@ -57,10 +57,11 @@ namespace fractal
 			 * Maps the given number of iterations to a given color
 			 *
 			 * @param iterations the iterations being mapped
+			 * @param maxIter    the iteration limit the iterations are normalised to
 			 *
 			 * @return the color calculated from the iterations
 			 */
-			virtual ColorRGB color(unsigned iterations) const = 0;
+			virtual ColorRGB color(unsigned iterations, unsigned maxIter) const = 0;
 		};
 
 		/**
@@ -102,10 +103,11 @@ namespace fractal
 			 * Maps the given number of iterations to a given color
 			 *
 			 * @param iterations the iterations being mapped
+			 * @param maxIter    the iteration limit the iterations are normalised to
 			 *
 			 * @return the color calculated from the iterations
 			 */
-			ColorRGB color(unsigned iterations) const;
+			ColorRGB color(unsigned iterations, unsigned maxIter) const;
 		};
 
 		/**
@@ -119,14 +121,14 @@ namespace fractal
 		{
 		public:
 			/**
-			 * The center of the sine wave
+			 * The center of the sine wave (the middle of a color channel)
 			 */
-			static const double CENTER = MAX_ITER/2 + 1;
+			static const double CENTER = 129;
 
 			/**
-			 * The width of the sine wave
+			 * The width of the sine wave (half of a color channel)
 			 */
-			static const double WIDTH  = MAX_ITER/2;
+			static const double WIDTH  = 128;
 
 			/**
 			 * The default phase shift of red
@@ -226,10 +228,11 @@ namespace fractal
 			 * Maps the given number of iterations to a given color
 			 *
 			 * @param iterations the iterations being mapped
+			 * @param maxIter    the iteration limit the iterations are normalised to
 			 *
 			 * @return the color calculated from the iterations
 			 */
-			ColorRGB color(unsigned iterations) const;
+			ColorRGB color(unsigned iterations, unsigned maxIter) const;
 		};
 	}
 }
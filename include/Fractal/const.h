@@ -19,7 +19,7 @@
 namespace fractal
 {
 	/**
-	 * Maximum iterations being performed
+	 * Default maximum iterations being performed (see setMaxIter)
 	 */
 	const int MAX_ITER = 256;
 }
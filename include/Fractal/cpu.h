@@ -0,0 +1,69 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+#ifndef _CPU_H_
+#define _CPU_H_
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * Instruction set extensions usable on this cpu (supported by both
+	 * the processor and the operating system)
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct CpuFeatures
+	{
+		/**
+		 * True if SSE2 is usable
+		 */
+		bool sse2;
+
+		/**
+		 * True if AVX2 is usable
+		 */
+		bool avx2;
+
+		/**
+		 * True if FMA3 is usable
+		 */
+		bool fma;
+
+		/**
+		 * True if AVX-512 Foundation is usable
+		 */
+		bool avx512f;
+
+		/**
+		 * True if BMI2 is usable
+		 */
+		bool bmi2;
+
+		/**
+		 * Detects the features of this cpu
+		 */
+		CpuFeatures();
+	};
+
+	/**
+	 * Returns the features of this cpu (detected once, at first call)
+	 *
+	 * @return the features of this cpu
+	 */
+	const CpuFeatures& getCpuFeatures();
+}
+
+#endif
@@ -0,0 +1,223 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+#ifndef _DDOUBLE_H_
+#define _DDOUBLE_H_
+
+// Libraries being used
+#include <string>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * A double-double number, the unevaluated sum of two doubles where lo is
+	 * at most half an ulp of hi (about 106 bits of mantissa)
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct ddouble
+	{
+		/**
+		 * The leading double
+		 */
+		double hi;
+
+		/**
+		 * The trailing double
+		 */
+		double lo;
+
+		/**
+		 * Creates a zero ddouble
+		 */
+		ddouble(): hi(0), lo(0) {}
+
+		/**
+		 * Creates a ddouble equal to the given double
+		 *
+		 * @param x the double
+		 */
+		ddouble(double x): hi(x), lo(0) {}
+
+		/**
+		 * Creates a ddouble from the given leading and trailing doubles
+		 *
+		 * @param hi the leading double
+		 * @param lo the trailing double
+		 */
+		ddouble(double hi, double lo): hi(hi), lo(lo) {}
+	};
+
+	/**
+	 * Returns the exact sum of a and b as a ddouble
+	 *
+	 * @param a the first double
+	 * @param b the second double
+	 *
+	 * @return the exact sum of a and b
+	 */
+	inline ddouble twoSum(double a, double b)
+	{
+		double s = a + b, v = s - a;
+		return ddouble(s, (a - (s - v)) + (b - v));
+	}
+
+	/**
+	 * Returns the exact sum of a and b as a ddouble, given |a| >= |b|
+	 *
+	 * @param a the larger double
+	 * @param b the smaller double
+	 *
+	 * @return the exact sum of a and b
+	 */
+	inline ddouble quickTwoSum(double a, double b)
+	{
+		double s = a + b;
+		return ddouble(s, b - (s - a));
+	}
+
+	/**
+	 * Returns the exact product of a and b as a ddouble (Dekker's algorithm,
+	 * which needs no fused multiply-add)
+	 *
+	 * @param a the first double
+	 * @param b the second double
+	 *
+	 * @return the exact product of a and b
+	 */
+	inline ddouble twoProd(double a, double b)
+	{
+		// Split each double into two 26-bit halves
+		const double SPLIT = 134217729.0; // 2^27 + 1
+		double t = SPLIT * a, ah = t - (t - a), al = a - ah;
+		t = SPLIT * b;
+		double bh = t - (t - b), bl = b - bh;
+
+		// Product and its rounding error
+		double p = a * b;
+		return ddouble(p, ((ah*bh - p) + ah*bl + al*bh) + al*bl);
+	}
+
+	/**
+	 * Returns the sum of the given ddoubles
+	 *
+	 * @param a the first ddouble
+	 * @param b the second ddouble
+	 *
+	 * @return the sum of the given ddoubles
+	 */
+	inline ddouble operator+(const ddouble& a, const ddouble& b)
+	{
+		ddouble s = twoSum(a.hi, b.hi), t = twoSum(a.lo, b.lo);
+		s = quickTwoSum(s.hi, s.lo + t.hi);
+		return quickTwoSum(s.hi, s.lo + t.lo);
+	}
+
+	/**
+	 * Returns the negation of the given ddouble
+	 *
+	 * @param a the ddouble
+	 *
+	 * @return the negation of the given ddouble
+	 */
+	inline ddouble operator-(const ddouble& a)
+	{
+		return ddouble(-a.hi, -a.lo);
+	}
+
+	/**
+	 * Returns the difference of the given ddoubles
+	 *
+	 * @param a the first ddouble
+	 * @param b the second ddouble
+	 *
+	 * @return the difference of the given ddoubles
+	 */
+	inline ddouble operator-(const ddouble& a, const ddouble& b)
+	{
+		return a + -b;
+	}
+
+	/**
+	 * Returns the product of the given ddoubles
+	 *
+	 * @param a the first ddouble
+	 * @param b the second ddouble
+	 *
+	 * @return the product of the given ddoubles
+	 */
+	inline ddouble operator*(const ddouble& a, const ddouble& b)
+	{
+		ddouble p = twoProd(a.hi, b.hi);
+		return quickTwoSum(p.hi, p.lo + (a.hi*b.lo + a.lo*b.hi));
+	}
+
+	/**
+	 * Returns the quotient of the given ddoubles
+	 *
+	 * @param a the dividend
+	 * @param b the divisor
+	 *
+	 * @return the quotient of the given ddoubles
+	 */
+	inline ddouble operator/(const ddouble& a, const ddouble& b)
+	{
+		// Long division, one double of the quotient at a time
+		double q1 = a.hi / b.hi;
+		ddouble r = a - b * ddouble(q1);
+		double q2 = r.hi / b.hi;
+		r = r - b * ddouble(q2);
+		double q3 = r.hi / b.hi;
+		return quickTwoSum(q1, q2) + ddouble(q3);
+	}
+
+	/**
+	 * Returns the square of the given ddouble
+	 *
+	 * @param a the ddouble
+	 *
+	 * @return the square of the given ddouble
+	 */
+	inline ddouble sqr(const ddouble& a)
+	{
+		ddouble p = twoProd(a.hi, a.hi);
+		return quickTwoSum(p.hi, p.lo + 2*a.hi*a.lo);
+	}
+
+	/**
+	 * Returns twice the given ddouble (exact)
+	 *
+	 * @param a the ddouble
+	 *
+	 * @return twice the given ddouble
+	 */
+	inline ddouble twice(const ddouble& a)
+	{
+		return ddouble(2*a.hi, 2*a.lo);
+	}
+
+	/**
+	 * Parses a ddouble from the given decimal string (such as "-0.75",
+	 * "1e-20" or a 32 digit offset), keeping every digit a ddouble can hold
+	 *
+	 * @param str the decimal string
+	 *
+	 * @return the ddouble parsed from the string (zero if it is not a number)
+	 */
+	ddouble parseDDouble(const std::string& str);
+}
+
+#endif
@@ -0,0 +1,187 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+#ifndef _FIXED_H_
+#define _FIXED_H_
+
+// Libraries being used
+#include <cmath>
+#include <string>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * The bits after the point of a fixed128 (Q4.124, so it holds numbers
+	 * in [-8, 8) to 2^-124, about 4.7e-38)
+	 */
+	const int FIXED_FRACTION_BITS = 124;
+
+	/**
+	 * A 128-bit fixed-point number with FIXED_FRACTION_BITS bits after the
+	 * point. Every operation is exact integer arithmetic (products are
+	 * truncated toward zero), so results are the same on every machine.
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct fixed128
+	{
+		/**
+		 * The number times 2^FIXED_FRACTION_BITS
+		 */
+		__int128 raw;
+
+		/**
+		 * Creates a zero fixed128
+		 */
+		fixed128(): raw(0) {}
+
+		/**
+		 * Creates a fixed128 equal to the given double (exact, as a double
+		 * has at most 53 bits, and saturated outside [-8, 8))
+		 *
+		 * @param x the double
+		 */
+		fixed128(double x)
+		{
+			const double limit = 8;
+			const __int128 max = ~((unsigned __int128)1 << 127);
+			if (x >= limit)
+				raw = max;
+			else if (x <= -limit)
+				raw = -max;
+			else
+				raw = (__int128)ldexp(x, FIXED_FRACTION_BITS);
+		}
+
+		/**
+		 * Returns the fixed128 with the given raw value
+		 *
+		 * @param raw the number times 2^FIXED_FRACTION_BITS
+		 *
+		 * @return the fixed128 with the given raw value
+		 */
+		static fixed128 fromRaw(__int128 raw)
+		{
+			fixed128 x;
+			x.raw = raw;
+			return x;
+		}
+
+		/**
+		 * Returns the number rounded to a double
+		 *
+		 * @return the number rounded to a double
+		 */
+		double toDouble() const
+		{
+			return ldexp((double)raw, -FIXED_FRACTION_BITS);
+		}
+	};
+
+	/**
+	 * Returns the sum of the given fixed128s
+	 *
+	 * @param a the first fixed128
+	 * @param b the second fixed128
+	 *
+	 * @return the sum of the given fixed128s
+	 */
+	inline fixed128 operator+(const fixed128& a, const fixed128& b)
+	{
+		return fixed128::fromRaw(a.raw + b.raw);
+	}
+
+	/**
+	 * Returns the difference of the given fixed128s
+	 *
+	 * @param a the first fixed128
+	 * @param b the second fixed128
+	 *
+	 * @return the difference of the given fixed128s
+	 */
+	inline fixed128 operator-(const fixed128& a, const fixed128& b)
+	{
+		return fixed128::fromRaw(a.raw - b.raw);
+	}
+
+	/**
+	 * Returns the product of the given fixed128s, truncated toward zero (the
+	 * product must be below 8 in magnitude)
+	 *
+	 * @param a the first fixed128
+	 * @param b the second fixed128
+	 *
+	 * @return the product of the given fixed128s
+	 */
+	inline fixed128 operator*(const fixed128& a, const fixed128& b)
+	{
+		// Magnitudes split into 64-bit halves
+		unsigned __int128 x = a.raw < 0 ? -(unsigned __int128)a.raw : a.raw;
+		unsigned __int128 y = b.raw < 0 ? -(unsigned __int128)b.raw : b.raw;
+		unsigned long long x1 = x >> 64, x0 = x, y1 = y >> 64, y0 = y;
+
+		// 256-bit product of the magnitudes (the middle column carries into the top)
+		unsigned __int128 p00 = (unsigned __int128)x0 * y0, p01 = (unsigned __int128)x0 * y1;
+		unsigned __int128 p10 = (unsigned __int128)x1 * y0, p11 = (unsigned __int128)x1 * y1;
+		unsigned __int128 mid = (p00 >> 64) + (unsigned long long)p01 + (unsigned long long)p10;
+		unsigned __int128 top = p11 + (p01 >> 64) + (p10 >> 64) + (mid >> 64);
+
+		// Keep the bits from FIXED_FRACTION_BITS up
+		const int shift = 128 - FIXED_FRACTION_BITS;
+		unsigned __int128 product = (top << shift) | ((unsigned long long)mid >> (64 - shift));
+		return fixed128::fromRaw((a.raw < 0) != (b.raw < 0) ? -(__int128)product : (__int128)product);
+	}
+
+	/**
+	 * Returns twice the given fixed128 (exact)
+	 *
+	 * @param a the fixed128
+	 *
+	 * @return twice the given fixed128
+	 */
+	inline fixed128 twice(const fixed128& a)
+	{
+		return fixed128::fromRaw(a.raw * 2);
+	}
+
+	/**
+	 * Returns true if the magnitude of the given fixed128 is below the given
+	 * whole number
+	 *
+	 * @param a     the fixed128
+	 * @param limit the whole number
+	 *
+	 * @return true if the magnitude of a is below the limit
+	 */
+	inline bool below(const fixed128& a, int limit)
+	{
+		const __int128 bound = (__int128)limit << FIXED_FRACTION_BITS;
+		return a.raw < bound && a.raw > -bound;
+	}
+
+	/**
+	 * Parses a fixed128 from the given decimal string (such as "-0.75",
+	 * "1e-20" or a 40 digit offset), keeping every bit a fixed128 can hold
+	 *
+	 * @param str the decimal string
+	 *
+	 * @return the fixed128 parsed from the string (zero if it is not a number,
+	 *         saturated outside [-8, 8))
+	 */
+	fixed128 parseFixed(const std::string& str);
+}
+
+#endif
@@ -13,12 +13,14 @@
 // Headers being used
 #include "const.h"
 #include "colormap.h"
+#include "kernel.h"
 #include "CImg/CImg.h"
 #include "transform.h"
 
 // Libraries being used
 #include <pugixml-1.7/src/pugixml.hpp>
 #include <complex>
+#include <string>
 
 /**
  * Contains functions and structs used by Fractal generator
@@ -28,24 +30,60 @@
  */
 namespace fractal
 {
+	/**
+	 * Rectangles at most this many pixels wide or high are iterated whole
+	 * instead of being split further by subdivision
+	 */
+	const unsigned SUBDIVIDE_SIZE = 6;
+
+	/**
+	 * How the pixels of each tile are picked for iterating
+	 */
+	enum RenderMode
+	{
+		/**
+		 * Every pixel is iterated
+		 */
+		BRUTE_FORCE_MODE,
+
+		/**
+		 * Only the border of each rectangle is iterated, and rectangles whose
+		 * border is one iteration count are filled with it (Mariani-Silver)
+		 */
+		SUBDIVIDE_MODE,
+
+		/**
+		 * Only the contours between iteration counts are iterated, traced in
+		 * from the edge, and the regions they enclose are filled
+		 */
+		TRACE_MODE
+	};
+
+	/**
+	 * The number of render modes
+	 */
+	const unsigned RENDER_MODE_COUNT = TRACE_MODE + 1;
+
 	/**
 	 * Computes the Julia set algorithm of the given complex numbers
 	 *
-	 * @param z the complex number to check
-	 * @param c the constant complex number
+	 * @param z       the complex number to check
+	 * @param c       the constant complex number
+	 * @param maxIter the iteration limit
 	 * 
 	 * @return the number of the iterations before infinity
 	 */
-	unsigned juliaSetAlgorithm(std::complex<double>& z, const std::complex<double>& c);
+	unsigned juliaSetAlgorithm(std::complex<double>& z, const std::complex<double>& c, unsigned maxIter = MAX_ITER);
 
 	/**
 	 * Computes the Mandelbrot set algorithm of the given complex numbers
 	 *
-	 * @param c the complex number to check
+	 * @param c       the complex number to check
+	 * @param maxIter the iteration limit
 	 * 
 	 * @return the number of the iterations before infinity
 	 */
-	unsigned mandelbrotSetAlgorithm(std::complex<double>& c);
+	unsigned mandelbrotSetAlgorithm(std::complex<double>& c, unsigned maxIter = MAX_ITER);
 
 	/**
 	 * Generates a Julia set image in the given object with the given complex constant
@@ -54,10 +92,11 @@ namespace fractal
 	 * @param c     the complex constant being used
 	 * @param trans the image configuration
 	 * @param map   the colormap being used
+	 * @param stats the lane usage of the kernel (added to if given)
 	 *
 	 * @return total number of iterations that were calculated
 	 */
-	unsigned generateJuliaSetImage(cimg_library::CImg<char>& image, const std::complex<double>& c, Transform& trans, const fractal::colormap::ColorMapRGB* map);
+	unsigned long long generateJuliaSetImage(cimg_library::CImg<char>& image, const std::complex<double>& c, Transform& trans, const fractal::colormap::ColorMapRGB* map, KernelStats* stats = 0);
 
 	/**
 	 * Generates a Mandelbrot set image in the given object with the given complex constant
@@ -65,10 +104,84 @@ namespace fractal
 	 * @param image the image object to generate the Mandelbrot set in
 	 * @param trans the image configuration
 	 * @param map   the colormap being used
+	 * @param stats the lane usage of the kernel (added to if given)
+	 *
+	 * @return total number of iterations that were calculated
+	 */
+	unsigned long long generateMandelbrotSetImage(cimg_library::CImg<char>& image, Transform& trans, const fractal::colormap::ColorMapRGB* map, KernelStats* stats = 0);
+
+	/**
+	 * Selects how the pixels of each tile are picked for iterating
+	 * ("brute-force", "subdivide" or "trace")
+	 *
+	 * @param name the name of the render mode
+	 *
+	 * @throw Error when name is not a render mode
+	 */
+	void selectRenderMode(std::string name) throw(Error);
+
+	/**
+	 * Returns the selected render mode
+	 *
+	 * @return the selected render mode
+	 */
+	RenderMode getRenderMode();
+
+	/**
+	 * Returns the name of the given render mode
+	 *
+	 * @param mode the render mode
+	 *
+	 * @return the name of the given render mode
+	 */
+	std::string getRenderModeName(RenderMode mode);
+
+	/**
+	 * Sets whether pixels mirroring other pixels of the image (under the
+	 * symmetry of the set) are copied instead of being iterated
+	 *
+	 * @param enabled true to copy mirrored pixels
+	 */
+	void setSymmetry(bool enabled);
+
+	/**
+	 * Sets whether perturbed pixels skip their first iterations with a series approximation
+	 *
+	 * @param enabled true to skip iterations with a series approximation
+	 */
+	void setSeriesApproximation(bool enabled);
+
+	/**
+	 * Sets whether perturbed pixels take bilinear steps
+	 *
+	 * @param enabled true to take bilinear steps
+	 */
+	void setBilinearApproximation(bool enabled);
+
+	/**
+	 * Generates a Julia or Mandelbrot set image by perturbation, for zooms far
+	 * beyond what a double-double can resolve. One reference orbit is computed
+	 * at the offset to the precision of the image, and every pixel is iterated
+	 * as a double distance from it. Pixels that glitch (Pauldelbrot's criterion,
+	 * or outliving the reference) are iterated again from a reference at the
+	 * worst glitched pixel, until none are left or MAX_REFERENCES is reached.
+	 * Each reference also fits a series approximation that lets every pixel
+	 * skip the iterations it predicts, and a table of bilinear steps that
+	 * lets pixels take many iterations at once. The first reference and its
+	 * table are kept for the next image about the same point.
+	 *
+	 * @param image  the image object to render
+	 * @param trans  the image configuration
+	 * @param map    the colormap being used
+	 * @param mbrot  true if the mandelbrot set is being rendered
+	 * @param c      the julia set complex constant
+	 * @param params the kernel parameters
+	 * @param stats  the lane usage of the kernel (added to if given)
 	 *
 	 * @return total number of iterations that were calculated
 	 */
-	unsigned generateMandelbrotSetImage(cimg_library::CImg<char>& image, Transform& trans, const fractal::colormap::ColorMapRGB* map);
+	unsigned long long generatePerturbedImage(cimg_library::CImg<char>& image, const Transform& trans, const fractal::colormap::ColorMapRGB* map,
+		bool mbrot, const std::complex<double>& c, const KernelParams& params, KernelStats* stats = 0);
 }
 
 #endif
\ No newline at end of file
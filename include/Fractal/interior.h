@@ -0,0 +1,104 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+#ifndef _INTERIOR_H_
+#define _INTERIOR_H_
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * A disk lying inside a hyperbolic component of the Mandelbrot set
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct InteriorDisk
+	{
+		/**
+		 * The real component of the center
+		 */
+		double real;
+
+		/**
+		 * The imaginary component of the center
+		 */
+		double imag;
+
+		/**
+		 * The radius of the disk
+		 */
+		double radius;
+	};
+
+	/**
+	 * Returns true if c lies inside the main cardioid of the Mandelbrot set
+	 *
+	 * @param cr the real component of c
+	 * @param ci the imaginary component of c
+	 *
+	 * @return true if c lies inside the main cardioid
+	 */
+	inline bool inMainCardioid(double cr, double ci)
+	{
+		double x = cr - 0.25, y2 = ci*ci;
+		double q = x*x + y2;
+		return q*(q + x) < 0.25*y2;
+	}
+
+	/**
+	 * Returns true if c lies inside the period-2 disk of the Mandelbrot set
+	 *
+	 * @param cr the real component of c
+	 * @param ci the imaginary component of c
+	 *
+	 * @return true if c lies inside the period-2 disk
+	 */
+	inline bool inPeriod2Disk(double cr, double ci)
+	{
+		double x = cr + 1.0;
+		return x*x + ci*ci < 0.0625;
+	}
+
+	/**
+	 * Returns true if c lies inside one of the disks of the interior table
+	 *
+	 * @param cr the real component of c
+	 * @param ci the imaginary component of c
+	 *
+	 * @return true if c lies inside one of the disks of the interior table
+	 */
+	bool inInteriorTable(double cr, double ci);
+
+	/**
+	 * Sets whether the interior table is checked by isInterior
+	 *
+	 * @param use true if the interior table is to be checked
+	 */
+	void setInteriorTable(bool use);
+
+	/**
+	 * Returns true if c is known to be in the Mandelbrot set without
+	 * iterating it (it lies in the main cardioid, the period-2 disk or,
+	 * if enabled, one of the disks of the interior table)
+	 *
+	 * @param cr the real component of c
+	 * @param ci the imaginary component of c
+	 *
+	 * @return true if c is known to be in the Mandelbrot set
+	 */
+	bool isInterior(double cr, double ci);
+}
+
+#endif
@@ -0,0 +1,1107 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+#ifndef _KERNEL_H_
+#define _KERNEL_H_
+
+// Headers being used
+#include "const.h"
+#include "error.h"
+#include "transform.h"
+#include "attractor.h"
+#include "ddouble.h"
+#include "fixed.h"
+#include "native.h"
+#include "program.h"
+
+// Libraries being used
+#include <string>
+#include <vector>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * The squared magnitude beyond which a point has gone to infinity
+	 */
+	const double BAILOUT = (SCALE/2) * (SCALE/2);
+
+	/**
+	 * The fraction of the pixel spacing within which an orbit that comes back
+	 * to an earlier point is taken to be cycling
+	 */
+	const double PERIOD_TOLERANCE = 1e-3;
+
+	/**
+	 * The component of z beyond which a point iterated with a transcendental
+	 * formula has gone to infinity (Re z for exp, |Im z| for sin and cos)
+	 */
+	const double TRANSCENDENTAL_BAILOUT = 50;
+
+	/**
+	 * The iterations added to the automatic iteration limit every time the zoom doubles
+	 */
+	const unsigned AUTO_ITER_PER_OCTAVE = 128;
+
+	/**
+	 * The exponent d of the iteration function z = z^d + c by default
+	 */
+	const double DEFAULT_EXPONENT = 2;
+
+	/**
+	 * The largest whole exponent with a multiply chain unrolled for it (larger
+	 * and fractional exponents are raised through the polar form of z)
+	 */
+	const unsigned MAX_WHOLE_EXPONENT = 8;
+
+	/**
+	 * The constant p of the Phoenix iteration function by default
+	 */
+	const std::complex<double> DEFAULT_PHOENIX(-0.5, 0);
+
+	/**
+	 * The iteration function points are iterated with
+	 */
+	enum Formula
+	{
+		/**
+		 * z = z^d + c
+		 */
+		STANDARD_FORMULA,
+
+		/**
+		 * z = (|Re z| + |Im z|i)^d + c (the Burning Ship)
+		 */
+		BURNING_SHIP_FORMULA,
+
+		/**
+		 * z = conj(z)^d + c (the Tricorn)
+		 */
+		TRICORN_FORMULA,
+
+		/**
+		 * z = z^d + c + p z', where z' is the z before this one (the Phoenix)
+		 */
+		PHOENIX_FORMULA,
+
+		/**
+		 * z = c e^z (the exponential family)
+		 */
+		EXP_FORMULA,
+
+		/**
+		 * z = c sin z (the sine family)
+		 */
+		SINE_FORMULA,
+
+		/**
+		 * z = c cos z (the cosine family)
+		 */
+		COSINE_FORMULA
+	};
+
+	/**
+	 * The number of formulas
+	 */
+	const unsigned FORMULA_COUNT = COSINE_FORMULA + 1;
+
+	/**
+	 * The number of points the program kernel runs each instruction over at once
+	 */
+	const unsigned PROGRAM_LANES = 64;
+
+	/**
+	 * The number of times the rounding error of a point (its number type's
+	 * epsilon times its magnitude) that the pixel spacing must be for the
+	 * number type to resolve the pixels when picking precisions automatically
+	 * (rounding errors grow as orbits are iterated, so it is large)
+	 */
+	const double PRECISION_MARGIN = 32768;
+
+	/**
+	 * The number type points are mapped and iterated in
+	 */
+	enum Precision
+	{
+		/**
+		 * Points are floats and run on the float kernel
+		 */
+		FLOAT_PRECISION,
+
+		/**
+		 * Points are doubles and run on the selected kernel
+		 */
+		DOUBLE_PRECISION,
+
+		/**
+		 * Points are double-doubles and run on the double-double kernel
+		 */
+		DOUBLE_DOUBLE_PRECISION,
+
+		/**
+		 * Points are 128-bit fixed-point numbers and run on the fixed-point
+		 * kernel, which gives the same iterations on every machine
+		 */
+		FIXED_PRECISION,
+
+		/**
+		 * Points are double distances from reference orbits computed to any
+		 * precision (see generatePerturbedImage)
+		 */
+		PERTURBATION_PRECISION
+	};
+
+	/**
+	 * The number of precisions
+	 */
+	const unsigned PRECISION_COUNT = PERTURBATION_PRECISION + 1;
+
+	/**
+	 * The cheapest precision picked automatically (floats round differently
+	 * enough to change pixels of ordinary images, so they are only used when
+	 * selected)
+	 */
+	const Precision AUTO_PRECISION = DOUBLE_PRECISION;
+
+	/**
+	 * Parameters shared by every point of a kernel batch
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct KernelParams
+	{
+		/**
+		 * The number of iterations after which a point is taken to never escape
+		 */
+		unsigned maxIter;
+
+		/**
+		 * The number type points are mapped and iterated in
+		 */
+		Precision precision;
+
+		/**
+		 * True if each tile is rendered in the cheapest precision that
+		 * resolves its pixels (which is never more than precision)
+		 */
+		bool automatic;
+
+		/**
+		 * Orbits that come back within this distance of the point saved at
+		 * the last power-of-two iteration (or of the capture point) are
+		 * cycling and never escape (0 turns periodicity detection off)
+		 */
+		double tolerance;
+
+		/**
+		 * True if orbits are compared against the capture point instead of
+		 * saved points
+		 */
+		bool capture;
+
+		/**
+		 * The real component of the capture point
+		 */
+		double captureReal;
+
+		/**
+		 * The imaginary component of the capture point
+		 */
+		double captureImag;
+
+		/**
+		 * The exponent d of the iteration function z = z^d + c
+		 */
+		double exponent;
+
+		/**
+		 * The iteration function points are iterated with
+		 */
+		Formula formula;
+
+		/**
+		 * The real component of the constant p of the Phoenix formula
+		 */
+		double phoenixReal;
+
+		/**
+		 * The imaginary component of the constant p of the Phoenix formula
+		 */
+		double phoenixImag;
+
+		/**
+		 * The compiled iteration function points are iterated with instead
+		 * of the formula (none if null)
+		 */
+		const Program* program;
+
+		/**
+		 * The native build of the program, iterated with instead of the
+		 * program kernel (none if null)
+		 */
+		const NativeProgram* native;
+
+		/**
+		 * Creates KernelParams with the default iteration limit and periodicity
+		 * detection off
+		 */
+		KernelParams();
+
+		/**
+		 * Creates KernelParams with the given iteration limit and periodicity tolerance
+		 *
+		 * @param maxIter   the iteration limit
+		 * @param tolerance the periodicity tolerance
+		 */
+		KernelParams(unsigned maxIter, double tolerance);
+
+		/**
+		 * Creates KernelParams with the given iteration limit that capture orbits
+		 * coming within the given radius of a point of an attracting cycle
+		 *
+		 * @param maxIter   the iteration limit
+		 * @param attractor the attracting cycle
+		 */
+		KernelParams(unsigned maxIter, const Attractor& attractor);
+
+		/**
+		 * Returns true if points are iterated with z = z^2 + c, which is the
+		 * only iteration function with vector, deep zoom and perturbation
+		 * kernels, an interior table and attracting cycles
+		 *
+		 * @return true if points are iterated with z = z^2 + c
+		 */
+		bool standard() const;
+
+		/**
+		 * Returns true if points are iterated with a transcendental formula
+		 * (c e^z, c sin z or c cos z), which ignore the exponent
+		 *
+		 * @return true if points are iterated with a transcendental formula
+		 */
+		bool transcendental() const;
+
+		/**
+		 * Returns the critical point of the iteration function, which Mandelbrot
+		 * sets start every orbit from (pi/2 for c sin z, 0 otherwise)
+		 *
+		 * @return the critical point of the iteration function
+		 */
+		double criticalPoint() const;
+
+		/**
+		 * Returns true if the orbit of conj(c) from a real starting point is
+		 * the conjugate of the orbit of c, so the Mandelbrot set is mirrored
+		 * in the real axis (every formula but the Burning Ship, and Phoenix
+		 * only with a real p)
+		 *
+		 * @return true if the Mandelbrot set is mirrored in the real axis
+		 */
+		bool conjugateSymmetric() const;
+
+		/**
+		 * Returns true if -z escapes after exactly as many iterations as z, so
+		 * the Julia set is mirrored through 0 (even whole exponents of z^d + c
+		 * and the Tricorn, any Burning Ship, c sin z and c cos z)
+		 *
+		 * @return true if the Julia set is mirrored through 0
+		 */
+		bool pointSymmetric() const;
+	};
+
+	/**
+	 * Counts how well a kernel keeps its lanes busy
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct KernelStats
+	{
+		/**
+		 * Lane-iterations spent iterating points
+		 */
+		unsigned long long used;
+
+		/**
+		 * Lane-iterations issued (used or idle)
+		 */
+		unsigned long long issued;
+
+		/**
+		 * Points checked against the reference kernel
+		 */
+		unsigned long long checked;
+
+		/**
+		 * Points whose iterations differ from the reference kernel
+		 */
+		unsigned long long mismatched;
+
+		/**
+		 * The largest difference in iterations from the reference kernel
+		 */
+		unsigned maxDifference;
+
+		/**
+		 * Reference orbits computed for perturbation
+		 */
+		unsigned references;
+
+		/**
+		 * Reference orbits reused from an earlier image
+		 */
+		unsigned reused;
+
+		/**
+		 * Points left glitched after the last reference orbit
+		 */
+		unsigned long long glitched;
+
+		/**
+		 * Iterations skipped by approximation instead of being iterated
+		 */
+		unsigned long long skipped;
+
+		/**
+		 * Pixels handed to the kernel (the rest were known without iterating them)
+		 */
+		unsigned long long iterated;
+
+		/**
+		 * Pixels copied from the pixel they mirror instead of being iterated
+		 */
+		unsigned long long mirrored;
+
+		/**
+		 * Pixels of subdivided or traced tiles checked against iterating every pixel
+		 */
+		unsigned long long compared;
+
+		/**
+		 * Pixels of subdivided or traced tiles that differ from iterating every pixel
+		 */
+		unsigned long long misfilled;
+
+		/**
+		 * Tiles rendered in each precision
+		 */
+		unsigned tiles[PRECISION_COUNT];
+
+		/**
+		 * Creates empty KernelStats
+		 */
+		KernelStats();
+
+		/**
+		 * Adds the given stats to these stats
+		 *
+		 * @param other the stats to add
+		 *
+		 * @return these stats
+		 */
+		KernelStats& operator+=(const KernelStats& other);
+
+		/**
+		 * Returns the fraction of issued lane-iterations that were used
+		 *
+		 * @return the fraction of issued lane-iterations that were used
+		 */
+		double utilisation() const;
+	};
+
+	/**
+	 * Computes the escape-time iterations of a batch of points. Point i starts
+	 * at z = zr[i] + zi[i]i and is iterated with z = z^2 + c, c = cr[i] + ci[i]i.
+	 * Julia sets start at the pixel with a constant c, and Mandelbrot sets start
+	 * at zero with c at the pixel. Iterations are stored as Count (unsigned char,
+	 * unsigned short or unsigned), which must be wide enough for params.maxIter.
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	template <typename Count>
+	struct EscapeKernel
+	{
+		/**
+		 * Computes the escape-time iterations of a batch of points
+		 *
+		 * @param zr     the real components of the starting points
+		 * @param zi     the imaginary components of the starting points
+		 * @param cr     the real components of the constants
+		 * @param ci     the imaginary components of the constants
+		 * @param count  the number of points in the batch
+		 * @param params the kernel parameters
+		 * @param out    the number of iterations before infinity of each point
+		 * @param stats  the lane usage of the kernel (added to)
+		 */
+		typedef void (*Function)(const double* zr, const double* zi,
+			const double* cr, const double* ci, unsigned count,
+			const KernelParams& params, Count* out, KernelStats& stats);
+
+		/**
+		 * Computes the escape-time iterations of a batch of float points
+		 *
+		 * @param zr     the real components of the starting points
+		 * @param zi     the imaginary components of the starting points
+		 * @param cr     the real components of the constants
+		 * @param ci     the imaginary components of the constants
+		 * @param count  the number of points in the batch
+		 * @param params the kernel parameters
+		 * @param out    the number of iterations before infinity of each point
+		 * @param stats  the lane usage of the kernel (added to)
+		 */
+		typedef void (*FloatFunction)(const float* zr, const float* zi,
+			const float* cr, const float* ci, unsigned count,
+			const KernelParams& params, Count* out, KernelStats& stats);
+	};
+
+	/**
+	 * Computes the batch one point at a time with juliaSetAlgorithm (the
+	 * reference that every other kernel is verified against, which always
+	 * runs every iteration)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void referenceKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch one point at a time with the iteration function
+	 * expanded by hand and a squared-magnitude bailout
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void scalarKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch two points at a time with SSE2
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("sse2")))
+	void sse2Kernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch four points at a time with AVX2 and FMA
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx2,fma")))
+	void avx2Kernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch eight points at a time with AVX-512, retiring
+	 * escaped lanes through mask registers
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx512f")))
+	void avx512Kernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch four points at a time with AVX2 and FMA, loading the
+	 * next point into a lane as soon as its point escapes, cycles or reaches the iteration limit
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx2,fma")))
+	void avx2RefillKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch eight points at a time with AVX-512, expand-loading
+	 * the next points into lanes as soon as their points escape, cycle or reach the iteration limit
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx512f,bmi2")))
+	void avx512RefillKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch one point at a time in float, for shallow zooms where
+	 * neighbouring pixels are far enough apart for a float to resolve
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void floatKernel(const float* zr, const float* zi,
+		const float* cr, const float* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch eight points at a time in float with AVX2 and FMA
+	 * (twice the lanes of the double kernel, for shallow zooms)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx2,fma")))
+	void avx2FloatKernel(const float* zr, const float* zi,
+		const float* cr, const float* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch sixteen points at a time in float with AVX-512
+	 * (twice the lanes of the double kernel, for shallow zooms)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx512f")))
+	void avx512FloatKernel(const float* zr, const float* zi,
+		const float* cr, const float* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch sixteen points at a time in float with AVX-512,
+	 * expand-loading the next points into lanes as soon as their points
+	 * escape, cycle or reach the iteration limit
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx512f,bmi2")))
+	void avx512FloatRefillKernel(const float* zr, const float* zi,
+		const float* cr, const float* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch one point at a time in double-double, for zooms where
+	 * neighbouring pixels are closer together than a double can resolve
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void ddKernel(const ddouble* zr, const ddouble* zi,
+		const ddouble* cr, const ddouble* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch one point at a time in 128-bit fixed point, which
+	 * gives exactly the same iterations on every machine. Points whose start
+	 * or constant lies outside the square of side 4 about zero can not be
+	 * held, and are computed with the scalar kernel instead (as are starts
+	 * outside the bailout circle whose constant is outside it too).
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void fixedKernel(const fixed128* zr, const fixed128* zi,
+		const fixed128* cr, const fixed128* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch one point at a time with the formula and exponent d
+	 * of the kernel parameters. Whole exponents up to MAX_WHOLE_EXPONENT are
+	 * raised by a multiply chain unrolled for that exponent, and every other
+	 * exponent through the polar form of z. Transcendental formulas are
+	 * iterated with transcendentalKernel.
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void formulaKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch four points at a time with AVX2 and FMA with the
+	 * formula of the kernel parameters (with avx2TranscendentalKernel for
+	 * transcendental formulas, and formulaKernel if the exponent is not 2)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx2,fma")))
+	void avx2FormulaKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch one point at a time with the transcendental formula
+	 * of the kernel parameters (using libm)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void transcendentalKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch four points at a time with AVX2 and FMA with the
+	 * transcendental formula of the kernel parameters (using the vector
+	 * complex exp, sin and cos of vmath.h)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx2,fma")))
+	void avx2TranscendentalKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch PROGRAM_LANES points at a time with the program of
+	 * the kernel parameters. Each iteration runs every instruction over every
+	 * lane, so decoding an instruction costs once per PROGRAM_LANES points,
+	 * and a lane is loaded with the next point as soon as its point escapes,
+	 * cycles or reaches the iteration limit.
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void programKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch NATIVE_LANES points at a time with the native build
+	 * of the program of the kernel parameters (which rounds exactly like the
+	 * program kernel, so it renders the same image)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void nativeKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Selects the kernel with the given name to render with ("auto" selects
+	 * the fastest kernel supported by this cpu)
+	 *
+	 * @param name the name of the kernel
+	 *
+	 * @throw Error when name is not a kernel or is not supported by this cpu
+	 */
+	void selectKernel(std::string name) throw(Error);
+
+	/**
+	 * Returns the name of the selected kernel
+	 *
+	 * @return the name of the selected kernel
+	 */
+	std::string getKernelName();
+
+	/**
+	 * Selects the precision to render with ("float", "double", "double-double",
+	 * "fixed", "perturbation" or "auto", which picks the cheapest precision
+	 * that resolves the pixels of each image and tile)
+	 *
+	 * @param name the name of the precision
+	 *
+	 * @throw Error when name is not a precision
+	 */
+	void selectPrecision(std::string name) throw(Error);
+
+	/**
+	 * Returns the name of the given precision
+	 *
+	 * @param precision the precision
+	 *
+	 * @return the name of the given precision
+	 */
+	std::string getPrecisionName(Precision precision);
+
+	/**
+	 * Returns the cheapest precision that resolves the pixels in the given
+	 * region of the image, whose spacing must be PRECISION_MARGIN times the
+	 * rounding error of the largest point in the region (float, double, or
+	 * perturbation where neither does)
+	 *
+	 * @param trans  the image configuration
+	 * @param x      the x coord of the region
+	 * @param y      the y coord of the region
+	 * @param width  the width of the region
+	 * @param height the height of the region
+	 *
+	 * @return the cheapest precision that resolves the pixels in the region
+	 */
+	Precision resolvingPrecision(const Transform& trans, unsigned x, unsigned y, unsigned width, unsigned height);
+
+	/**
+	 * Sets whether orbits are checked for cycles
+	 *
+	 * @param period true if orbits are to be checked for cycles
+	 */
+	void setPeriodicity(bool period);
+
+	/**
+	 * Sets the iteration limit (0 picks the limit from the zoom of each image)
+	 *
+	 * @param limit the iteration limit
+	 */
+	void setMaxIter(unsigned limit);
+
+	/**
+	 * Returns the iteration limit for rendering with the given transform
+	 * (MAX_ITER plus AUTO_ITER_PER_OCTAVE for every doubling of the zoom in auto mode)
+	 *
+	 * @param trans the image configuration
+	 *
+	 * @return the iteration limit for rendering with the given transform
+	 */
+	unsigned maxIterations(const Transform& trans);
+
+	/**
+	 * Sets the exponent d of the iteration function z = z^d + c
+	 *
+	 * @param d the exponent
+	 *
+	 * @throw Error when d is below 2
+	 */
+	void setExponent(double d) throw(Error);
+
+	/**
+	 * Selects the iteration function to render with ("standard",
+	 * "burning-ship", "tricorn", "phoenix", "exp", "sin" or "cos")
+	 *
+	 * @param name the name of the formula
+	 *
+	 * @throw Error when name is not a formula
+	 */
+	void selectFormula(std::string name) throw(Error);
+
+	/**
+	 * Returns the name of the given formula
+	 *
+	 * @param formula the formula
+	 *
+	 * @return the name of the given formula
+	 */
+	std::string getFormulaName(Formula formula);
+
+	/**
+	 * Sets the constant p of the Phoenix formula
+	 *
+	 * @param p the constant p
+	 */
+	void setPhoenix(const std::complex<double>& p);
+
+	/**
+	 * Compiles the given formula of z and c to iterate points with instead
+	 * of the selected formula and exponent (empty goes back to them), and
+	 * builds it into native code if set to
+	 *
+	 * @param formula the iteration function of z and c
+	 *
+	 * @throw Error when the formula can not be compiled
+	 */
+	void setProgram(const std::string& formula) throw(Error);
+
+	/**
+	 * Sets whether programs are built into native code with the local
+	 * compiler (falling back to the program kernel if they can not be),
+	 * and the directory native builds are cached in
+	 *
+	 * @param build true if programs are to be built into native code
+	 * @param cache the directory native builds are cached in (the default if empty)
+	 */
+	void setNative(bool build, const std::string& cache);
+
+	/**
+	 * Returns why the program could not be built into native code
+	 *
+	 * @return why the program could not be built (empty if it was, or was not to be)
+	 */
+	std::string getNativeError();
+
+	/**
+	 * Returns the kernel parameters for rendering with the given transform
+	 *
+	 * @param trans the image configuration
+	 *
+	 * @return the kernel parameters for rendering with the given transform
+	 */
+	KernelParams kernelParams(const Transform& trans);
+
+	/**
+	 * Sets whether julia set orbits are captured by the attracting cycle of c
+	 *
+	 * @param capture true if orbits are to be captured by the attracting cycle
+	 */
+	void setCapture(bool capture);
+
+	/**
+	 * Returns the kernel parameters for rendering the julia set of c with the
+	 * given transform (capturing orbits by the attracting cycle of c if it has one)
+	 *
+	 * @param trans the image configuration
+	 * @param c     the julia set complex constant
+	 *
+	 * @return the kernel parameters for rendering the julia set
+	 */
+	KernelParams kernelParams(const Transform& trans, const std::complex<double>& c);
+
+	/**
+	 * Sets whether every batch is also computed with the reference kernel
+	 * and checked against it
+	 *
+	 * @param verify true if batches are to be verified
+	 */
+	void setVerify(bool verify);
+
+	/**
+	 * Returns true if batches are verified
+	 *
+	 * @return true if batches are verified
+	 */
+	bool getVerify();
+
+	/**
+	 * Returns true if float tiles are iterated as floats (the reference
+	 * kernel only iterates doubles, and verifying checks every batch against
+	 * it, so with either float tiles are rendered in double)
+	 *
+	 * @return true if float tiles are iterated as floats
+	 */
+	bool floatKernels();
+
+	/**
+	 * Computes the batch with the selected kernel, checking it against the
+	 * reference kernel if verification is on (or with the formula kernel of
+	 * the selected kernel or the program kernel, unverified, if the formula
+	 * is not z^2 + c)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage and verification of the kernel (added to)
+	 */
+	template <typename Count>
+	void runKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch with the float kernel of the selected kernel (which
+	 * is never verified, as float tiles are rendered in double while verifying)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void runKernel(const float* zr, const float* zi,
+		const float* cr, const float* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch with the double-double kernel (which is never verified,
+	 * as the reference kernel can not resolve the points)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void runKernel(const ddouble* zr, const ddouble* zi,
+		const ddouble* cr, const ddouble* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Computes the batch with the fixed-point kernel (which is never verified,
+	 * as the reference kernel can not resolve the points)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void runKernel(const fixed128* zr, const fixed128* zi,
+		const fixed128* cr, const fixed128* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats);
+
+	/**
+	 * Returns the names of all of the kernels
+	 *
+	 * @return the names of all of the kernels
+	 */
+	std::vector<std::string> getKernels();
+}
+
+#endif
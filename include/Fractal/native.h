@@ -0,0 +1,169 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+#ifndef _NATIVE_H_
+#define _NATIVE_H_
+
+// Headers being used
+#include "program.h"
+
+// Libraries being used
+#include <string>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * The compiler native programs are built with
+	 */
+	const char* const NATIVE_COMPILER = "g++";
+
+	/**
+	 * The flags native programs are built with (contraction is off so that
+	 * native programs round exactly like the program kernel)
+	 */
+	const char* const NATIVE_FLAGS = "-O2 -std=gnu++98 -ffp-contract=off -fPIC -shared";
+
+	/**
+	 * The number of points native kernels iterate at once
+	 */
+	const unsigned NATIVE_LANES = 8;
+
+	/**
+	 * The signature of the native kernel of each count width, which iterates
+	 * the batch NATIVE_LANES points at a time and adds its lane usage
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	template <typename Count>
+	struct NativeKernel
+	{
+		/**
+		 * The kernel (zr, zi, cr, ci, count, iteration limit, squared
+		 * periodicity tolerance, out, lane iterations used and issued)
+		 */
+		typedef void (*Function)(const double*, const double*, const double*, const double*,
+			unsigned, unsigned, double, Count*, unsigned long long*, unsigned long long*);
+	};
+
+	/**
+	 * A program translated into C++, built into a shared object with the
+	 * local compiler and loaded into the renderer. Shared objects are cached
+	 * on disk under the hash of their source, so a formula is only ever
+	 * built once per cache.
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	class NativeProgram
+	{
+	private:
+		/**
+		 * The formula of the loaded program (empty if none is loaded)
+		 */
+		std::string m_source;
+
+		/**
+		 * Why the last program could not be loaded (empty if it was)
+		 */
+		std::string m_error;
+
+		/**
+		 * The handle of the loaded shared object
+		 */
+		void* m_handle;
+
+		/**
+		 * The kernel of each count width (8, 16 and 32 bits)
+		 */
+		void* m_functions[3];
+
+		/**
+		 * NativePrograms own their shared object, so they are never copied
+		 */
+		NativeProgram(const NativeProgram&);
+		NativeProgram& operator=(const NativeProgram&);
+	public:
+		/**
+		 * Creates a NativeProgram with nothing loaded
+		 */
+		NativeProgram();
+
+		/**
+		 * Unloads the program
+		 */
+		~NativeProgram();
+
+		/**
+		 * Loads the given program, building it into the given cache directory
+		 * unless it was built before (if it can not be built or loaded, nothing
+		 * is loaded and the reason is kept)
+		 *
+		 * @param program the program
+		 * @param cache   the directory shared objects are cached in
+		 *
+		 * @return true if the program was loaded
+		 */
+		bool load(const Program& program, const std::string& cache);
+
+		/**
+		 * Unloads the program
+		 */
+		void unload();
+
+		/**
+		 * Returns true if a program is loaded
+		 *
+		 * @return true if a program is loaded
+		 */
+		bool loaded() const;
+
+		/**
+		 * Returns why the last program could not be loaded
+		 *
+		 * @return why the last program could not be loaded (empty if it was)
+		 */
+		const std::string& error() const;
+
+		/**
+		 * Returns the kernel of the given count width
+		 *
+		 * @param width the count width in bytes (1, 2 or 4)
+		 *
+		 * @return the kernel (a NativeKernel function)
+		 */
+		void* function(unsigned width) const;
+	};
+
+	/**
+	 * Returns the C++ source of the native kernels of the given program
+	 *
+	 * @param program the program
+	 *
+	 * @return the C++ source of the native kernels of the program
+	 */
+	std::string nativeSource(const Program& program);
+
+	/**
+	 * Returns the directory native programs are cached in by default
+	 * ($XDG_CACHE_HOME/fractal or ~/.cache/fractal, or empty if there is no
+	 * per-user cache directory)
+	 *
+	 * @return the directory native programs are cached in by default
+	 */
+	std::string defaultNativeCache();
+}
+
+#endif
@@ -0,0 +1,186 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+#ifndef _PROGRAM_H_
+#define _PROGRAM_H_
+
+// Headers being used
+#include "error.h"
+
+// Libraries being used
+#include <complex>
+#include <string>
+#include <vector>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * The most registers a program may use (the formula is too long beyond it)
+	 */
+	const unsigned MAX_REGISTERS = 64;
+
+	/**
+	 * The largest whole power a program may raise to with ^
+	 */
+	const unsigned MAX_PROGRAM_POWER = 64;
+
+	/**
+	 * The register holding z in every program
+	 */
+	const unsigned Z_REGISTER = 0;
+
+	/**
+	 * The register holding c in every program
+	 */
+	const unsigned C_REGISTER = 1;
+
+	/**
+	 * An operation of a program instruction on complex registers
+	 */
+	enum Opcode
+	{
+		/**
+		 * dst = a + b
+		 */
+		ADD_OPCODE,
+
+		/**
+		 * dst = a - b
+		 */
+		SUB_OPCODE,
+
+		/**
+		 * dst = a * b
+		 */
+		MUL_OPCODE,
+
+		/**
+		 * dst = a / b
+		 */
+		DIV_OPCODE,
+
+		/**
+		 * dst = a * a
+		 */
+		SQUARE_OPCODE,
+
+		/**
+		 * dst = -a
+		 */
+		NEG_OPCODE,
+
+		/**
+		 * dst = conj(a)
+		 */
+		CONJ_OPCODE,
+
+		/**
+		 * dst = Re a
+		 */
+		REAL_OPCODE,
+
+		/**
+		 * dst = Im a
+		 */
+		IMAG_OPCODE
+	};
+
+	/**
+	 * One program instruction (every instruction writes a register no
+	 * earlier instruction wrote, so dst is never a or b)
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct Instruction
+	{
+		/**
+		 * The operation
+		 */
+		Opcode op;
+
+		/**
+		 * The register written
+		 */
+		unsigned char dst;
+
+		/**
+		 * The first register read
+		 */
+		unsigned char a;
+
+		/**
+		 * The second register read (unused by one-register operations)
+		 */
+		unsigned char b;
+	};
+
+	/**
+	 * An iteration function of z and c (such as "z*z*z + c*z + 0.3") compiled
+	 * into register bytecode. Registers hold z, c, then every constant, then
+	 * the result of every instruction. Constant parts of the formula are
+	 * folded while compiling, so they cost nothing per iteration.
+	 *
+	 * Formulas are made of z, c, numbers (with an i after them if imaginary,
+	 * or i alone), + - * /, ^ with a whole power up to MAX_PROGRAM_POWER,
+	 * parentheses, and the functions conj, re and im.
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct Program
+	{
+		/**
+		 * The formula the program was compiled from
+		 */
+		std::string source;
+
+		/**
+		 * The instructions, run in order every iteration
+		 */
+		std::vector<Instruction> code;
+
+		/**
+		 * The values of the constant registers (from register 2)
+		 */
+		std::vector<std::complex<double> > constants;
+
+		/**
+		 * The number of registers the program uses
+		 */
+		unsigned registers;
+
+		/**
+		 * The register holding the next z once the instructions have run
+		 */
+		unsigned result;
+
+		/**
+		 * Creates an empty program (z = z)
+		 */
+		Program();
+
+		/**
+		 * Compiles the given formula
+		 *
+		 * @param formula the iteration function of z and c
+		 *
+		 * @throw Error when the formula can not be parsed or uses too many registers
+		 */
+		Program(const std::string& formula) throw(Error);
+	};
+}
+
+#endif
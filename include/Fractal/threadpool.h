@@ -0,0 +1,192 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+#ifndef _THREADPOOL_H_
+#define _THREADPOOL_H_
+
+// Libraries being used
+#include <pthread.h>
+#include <deque>
+#include <vector>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * A unit of work run by the ThreadPool
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	class Task
+	{
+	public:
+		/**
+		 * Destroys the Task
+		 */
+		virtual ~Task();
+
+		/**
+		 * Runs the task
+		 */
+		virtual void run() = 0;
+	};
+
+	/**
+	 * Persistent pool of worker threads. Each worker owns a queue of tasks
+	 * and steals from the other queues once its own runs dry.
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	class ThreadPool
+	{
+	private:
+		/**
+		 * A worker thread and its task queue
+		 */
+		struct Worker
+		{
+			/**
+			 * The pool the worker belongs to
+			 */
+			ThreadPool* pool;
+
+			/**
+			 * The index of the worker in the pool
+			 */
+			unsigned index;
+
+			/**
+			 * The worker thread
+			 */
+			pthread_t thread;
+
+			/**
+			 * Guards the task queue
+			 */
+			pthread_mutex_t lock;
+
+			/**
+			 * The task queue (owner pops the back, thieves take the front)
+			 */
+			std::deque<Task*> queue;
+		};
+
+		/**
+		 * The workers in the pool
+		 */
+		std::vector<Worker*> m_workers;
+
+		/**
+		 * Guards the pool state
+		 */
+		pthread_mutex_t m_lock;
+
+		/**
+		 * Signalled when a new batch is posted
+		 */
+		pthread_cond_t m_wake;
+
+		/**
+		 * Signalled when a batch is finished
+		 */
+		pthread_cond_t m_done;
+
+		/**
+		 * Incremented for every batch posted
+		 */
+		unsigned m_generation;
+
+		/**
+		 * Number of tasks in the current batch that have not finished
+		 */
+		volatile unsigned m_pending;
+
+		/**
+		 * True when the workers should exit
+		 */
+		bool m_stop;
+
+		/**
+		 * Returns the next task for the given worker (0 if none are left)
+		 *
+		 * @param index the index of the worker
+		 *
+		 * @return the next task for the given worker
+		 */
+		Task* next(unsigned index);
+
+		/**
+		 * The main loop of a worker thread
+		 *
+		 * @param arg the worker
+		 */
+		static void* work(void* arg);
+
+		/**
+		 * ThreadPools are not copyable
+		 */
+		ThreadPool(const ThreadPool& other);
+	public:
+		/**
+		 * Creates a ThreadPool with the given number of threads
+		 *
+		 * @param threads the number of threads (all cores if 0)
+		 */
+		ThreadPool(unsigned threads);
+
+		/**
+		 * Stops and joins all of the threads
+		 */
+		~ThreadPool();
+
+		/**
+		 * Returns the number of threads in the pool
+		 *
+		 * @return the number of threads in the pool
+		 */
+		unsigned size() const;
+
+		/**
+		 * Runs all of the given tasks, returning once every one is finished
+		 *
+		 * @param tasks the tasks to run
+		 */
+		void run(const std::vector<Task*>& tasks);
+	};
+
+	/**
+	 * Returns the number of available processor cores
+	 *
+	 * @return the number of available processor cores
+	 */
+	unsigned coreCount();
+
+	/**
+	 * Creates the shared ThreadPool with the given number of threads
+	 *
+	 * @param threads the number of threads (all cores if 0)
+	 */
+	void initThreadPool(unsigned threads);
+
+	/**
+	 * Returns the shared ThreadPool (created with all cores if not initialized)
+	 *
+	 * @return the shared ThreadPool
+	 */
+	ThreadPool& getThreadPool();
+}
+
+#endif
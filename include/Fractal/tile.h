@@ -0,0 +1,102 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+#ifndef _TILE_H_
+#define _TILE_H_
+
+// Libraries being used
+#include <vector>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * The width and height of a render tile
+	 */
+	const unsigned TILE_SIZE = 64;
+
+	/**
+	 * A rectangular region of the image
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct Tile
+	{
+		/**
+		 * The x coord of the top left pixel
+		 */
+		unsigned x;
+
+		/**
+		 * The y coord of the top left pixel
+		 */
+		unsigned y;
+
+		/**
+		 * The width of the tile
+		 */
+		unsigned width;
+
+		/**
+		 * The height of the tile
+		 */
+		unsigned height;
+
+		/**
+		 * Creates an empty Tile
+		 */
+		Tile();
+
+		/**
+		 * Creates a Tile with the given location and size
+		 *
+		 * @param x the x coord of the top left pixel
+		 * @param y the y coord of the top left pixel
+		 * @param w the width of the tile
+		 * @param h the height of the tile
+		 */
+		Tile(unsigned x, unsigned y, unsigned w, unsigned h);
+
+		/**
+		 * Returns the area of the tile
+		 *
+		 * @return the area of the tile
+		 */
+		unsigned area() const;
+	};
+
+	/**
+	 * Splits an image of the given size into tiles (row-major order)
+	 *
+	 * @param width  the width of the image
+	 * @param height the height of the image
+	 * @param size   the width and height of each tile
+	 *
+	 * @return the tiles covering the image
+	 */
+	std::vector<Tile> splitTiles(unsigned width, unsigned height, unsigned size = TILE_SIZE);
+
+	/**
+	 * Splits the given region of an image into tiles (row-major order)
+	 *
+	 * @param region the region of the image
+	 * @param size   the width and height of each tile
+	 *
+	 * @return the tiles covering the region
+	 */
+	std::vector<Tile> splitTiles(const Tile& region, unsigned size = TILE_SIZE);
+}
+
+#endif
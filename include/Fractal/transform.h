@@ -10,9 +10,14 @@
 #ifndef _TRANSFORM_H_
 #define _TRANSFORM_H_
 
+// Headers being used
+#include "ddouble.h"
+#include "fixed.h"
+
 // Libraries being used
 #include <pugixml-1.7/src/pugixml.hpp>
 #include <complex>
+#include <string>
 
 /**
  * Contains functions and structs used by Fractal generator
@@ -136,6 +141,38 @@ namespace fractal
 		 */
 		std::complex<double> offset;
 
+		/**
+		 * The real component of the offset in double-double (offset holds its leading double)
+		 */
+		ddouble offsetReal;
+
+		/**
+		 * The imaginary component of the offset in double-double (offset holds its leading double)
+		 */
+		ddouble offsetImag;
+
+		/**
+		 * The real component of the offset in 128-bit fixed point
+		 */
+		fixed128 offsetRealFixed;
+
+		/**
+		 * The imaginary component of the offset in 128-bit fixed point
+		 */
+		fixed128 offsetImagFixed;
+
+		/**
+		 * The real component of the offset as the decimal string it was given as
+		 * (every digit of it, for reference orbits deeper than a double-double)
+		 */
+		std::string offsetRealDigits;
+
+		/**
+		 * The imaginary component of the offset as the decimal string it was given as
+		 * (every digit of it, for reference orbits deeper than a double-double)
+		 */
+		std::string offsetImagDigits;
+
 		/**
 		 * The shift complex
 		 */
@@ -163,11 +200,11 @@ namespace fractal
 		 *
 		 * @param s the size of the image
 		 * @param z the zoom scale of the image
-		 * @param x the x offset of the image
-		 * @param y the y offset of the image
+		 * @param x the x offset of the image (as a decimal string)
+		 * @param y the y offset of the image (as a decimal string)
 		 * @param a the rotation angle of the image
 		 */
-		Transform(ImgSize s, double z, double x, double y, double a);
+		Transform(ImgSize s, double z, const std::string& x, const std::string& y, double a);
 
 		/**
 		 * Creates a transform with the given s and xml
@@ -184,6 +221,23 @@ namespace fractal
 		 */
 		Transform(const Transform& other);
 
+		/**
+		 * Returns the distance in the complex plane between neighbouring pixels
+		 *
+		 * @return the distance between neighbouring pixels
+		 */
+		double spacing() const;
+
+		/**
+		 * Returns the distance in the complex plane of the given pixel from the offset
+		 *
+		 * @param x the x coord of the pixel
+		 * @param y the y coord of the pixel
+		 *
+		 * @return the distance of the given pixel from the offset
+		 */
+		std::complex<double> distance(const double& x, const double& y) const;
+
 		/**
 		 * Returns the complex number mapped at the given pixel by the transform
 		 *
@@ -192,7 +246,29 @@ namespace fractal
 		 *
 		 * @return the complex number mapped at the given pixel by the transform
 		 */
-		std::complex<double> operator()(const double& x, const double& y);
+		std::complex<double> operator()(const double& x, const double& y) const;
+
+		/**
+		 * Maps the given pixel to the complex plane in double-double, so that
+		 * neighbouring pixels stay apart far beyond a zoom of 1e13
+		 *
+		 * @param x    the x coord of the pixel
+		 * @param y    the y coord of the pixel
+		 * @param real the real component mapped at the pixel (set)
+		 * @param imag the imaginary component mapped at the pixel (set)
+		 */
+		void map(const double& x, const double& y, ddouble& real, ddouble& imag) const;
+
+		/**
+		 * Maps the given pixel to the complex plane in 128-bit fixed point, so
+		 * that every machine maps it to exactly the same point
+		 *
+		 * @param x    the x coord of the pixel
+		 * @param y    the y coord of the pixel
+		 * @param real the real component mapped at the pixel (set)
+		 * @param imag the imaginary component mapped at the pixel (set)
+		 */
+		void map(const double& x, const double& y, fixed128& real, fixed128& imag) const;
 	};
 }
 
@@ -0,0 +1,431 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+#ifndef _VMATH_H_
+#define _VMATH_H_
+
+// Libraries being used
+#include <cmath>
+#include <immintrin.h>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * The largest magnitude vsincos reduces by pi/2 itself (larger arguments,
+	 * which the three-part reduction can not resolve, go through libm)
+	 */
+	const double SINCOS_LIMIT = 1e6;
+
+	/**
+	 * Returns the given doubles, which must be whole and below 2^51 in
+	 * magnitude, as 64-bit integers
+	 *
+	 * @param x the doubles
+	 *
+	 * @return the doubles as 64-bit integers
+	 */
+	__attribute__((target("avx2,fma")))
+	inline __m256i vtoint(__m256d x)
+	{
+		// Adding 1.5 * 2^52 puts the integer in the low bits of the mantissa
+		const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+		return _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(x, magic)), _mm256_castpd_si256(magic));
+	}
+
+	/**
+	 * Returns 2^n for whole n from -1022 to 1023
+	 *
+	 * @param n the powers
+	 *
+	 * @return 2^n
+	 */
+	__attribute__((target("avx2,fma")))
+	inline __m256d vpow2(__m256d n)
+	{
+		return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(vtoint(n), _mm256_set1_epi64x(1023)), 52));
+	}
+
+	/**
+	 * Returns e^x, within 1 ulp (correctly rounded in most cases). Results
+	 * below the smallest normal double are flushed to zero or rounded twice.
+	 *
+	 * @param x the exponents
+	 *
+	 * @return e^x
+	 */
+	__attribute__((target("avx2,fma")))
+	inline __m256d vexp(__m256d x)
+	{
+		// Keep 2^n (taken in two halves) within the exponent range
+		x = _mm256_max_pd(_mm256_min_pd(x, _mm256_set1_pd(710)), _mm256_set1_pd(-746));
+
+		// x = n ln 2 + r, |r| <= ln 2 / 2 (ln 2 split so that n ln2hi is exact)
+		__m256d n = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(1.44269504088896338700e+00)),
+			_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(6.93147180369123816490e-01), x);
+		r = _mm256_fnmadd_pd(n, _mm256_set1_pd(1.90821492927058770002e-10), r);
+
+		// e^r by its Taylor series to r^13 (the next term is below 2^-57)
+		__m256d p = _mm256_set1_pd(1.0 / 6227020800.0);
+		p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 479001600.0));
+		p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 39916800.0));
+		p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 3628800.0));
+		p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 362880.0));
+		p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 40320.0));
+		p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 5040.0));
+		p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 720.0));
+		p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 120.0));
+		p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 24.0));
+		p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 6.0));
+		p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(0.5));
+		p = _mm256_fmadd_pd(_mm256_mul_pd(p, r), r, r);
+		p = _mm256_add_pd(p, _mm256_set1_pd(1));
+
+		// Scale by 2^n in two halves (so that neither overflows)
+		__m256d half = _mm256_floor_pd(_mm256_mul_pd(n, _mm256_set1_pd(0.5)));
+		return _mm256_mul_pd(_mm256_mul_pd(p, vpow2(half)), vpow2(_mm256_sub_pd(n, half)));
+	}
+
+	/**
+	 * Computes sin x and cos x, each within 1 ulp for |x| up to SINCOS_LIMIT
+	 * (and as accurately as libm beyond it)
+	 *
+	 * @param x the angles
+	 * @param s sin x (set)
+	 * @param c cos x (set)
+	 */
+	__attribute__((target("avx2,fma")))
+	inline void vsincos(__m256d x, __m256d& s, __m256d& c)
+	{
+		// x = q pi/2 + r + rr, |r| <= pi/4 (pi/2 split into three doubles, the
+		// first of which q times exactly cancels x, and the rest carried in rr)
+		__m256d q  = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(6.36619772367581382433e-01)),
+			_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m256d r1 = _mm256_fnmadd_pd(q, _mm256_set1_pd(1.57079632679489655800e+00), x);
+		__m256d ph = _mm256_mul_pd(q, _mm256_set1_pd(6.12323399573676603587e-17));
+		__m256d pl = _mm256_fmsub_pd(q, _mm256_set1_pd(6.12323399573676603587e-17), ph);
+		__m256d t  = _mm256_sub_pd(r1, ph);
+		__m256d v  = _mm256_sub_pd(t, r1);
+		__m256d te = _mm256_sub_pd(_mm256_sub_pd(r1, _mm256_sub_pd(t, v)), _mm256_add_pd(ph, v));
+		te = _mm256_sub_pd(te, _mm256_fmadd_pd(q, _mm256_set1_pd(-1.49738490485916983e-33), pl));
+		__m256d r  = _mm256_add_pd(t, te);
+		__m256d rr = _mm256_sub_pd(te, _mm256_sub_pd(r, t));
+		__m256d z  = _mm256_mul_pd(r, r);
+
+		// sin(r + rr) = r + r^3 S(r^2) + rr cos r (fdlibm's __kernel_sin)
+		__m256d vz = _mm256_mul_pd(z, r);
+		__m256d ps = _mm256_set1_pd(1.58969099521155010221e-10);
+		ps = _mm256_fmadd_pd(ps, z, _mm256_set1_pd(-2.50507602534068634195e-08));
+		ps = _mm256_fmadd_pd(ps, z, _mm256_set1_pd(2.75573137070700676789e-06));
+		ps = _mm256_fmadd_pd(ps, z, _mm256_set1_pd(-1.98412698298579493134e-04));
+		ps = _mm256_fmadd_pd(ps, z, _mm256_set1_pd(8.33333333332248946124e-03));
+		ps = _mm256_fmsub_pd(z, _mm256_fnmadd_pd(vz, ps, _mm256_mul_pd(rr, _mm256_set1_pd(0.5))), rr);
+		ps = _mm256_sub_pd(r, _mm256_fnmadd_pd(vz, _mm256_set1_pd(-1.66666666666666324348e-01), ps));
+
+		// cos(r + rr) = 1 - r^2/2 + r^4 C(r^2) - r rr (fdlibm's __kernel_cos,
+		// with 1 - r^2/2 rounded once and its rounding error added back)
+		__m256d pc = _mm256_set1_pd(-1.13596475577881948265e-11);
+		pc = _mm256_fmadd_pd(pc, z, _mm256_set1_pd(2.08757232129817482790e-09));
+		pc = _mm256_fmadd_pd(pc, z, _mm256_set1_pd(-2.75573143513906633035e-07));
+		pc = _mm256_fmadd_pd(pc, z, _mm256_set1_pd(2.48015872894767294178e-05));
+		pc = _mm256_fmadd_pd(pc, z, _mm256_set1_pd(-1.38888888888741095749e-03));
+		pc = _mm256_fmadd_pd(pc, z, _mm256_set1_pd(4.16666666666666019037e-02));
+		__m256d hz = _mm256_mul_pd(z, _mm256_set1_pd(0.5));
+		__m256d w  = _mm256_sub_pd(_mm256_set1_pd(1), hz);
+		__m256d e  = _mm256_fnmadd_pd(r, _mm256_mul_pd(r, _mm256_set1_pd(0.5)), _mm256_sub_pd(_mm256_set1_pd(1), w));
+		pc = _mm256_add_pd(w, _mm256_add_pd(e, _mm256_fmsub_pd(_mm256_mul_pd(z, z), pc, _mm256_mul_pd(r, rr))));
+
+		// Swap in odd quadrants, and negate sin in quadrants 2 and 3 and cos in 1 and 2
+		__m256i k    = vtoint(q);
+		__m256d odd  = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(k, _mm256_set1_epi64x(1)), _mm256_set1_epi64x(1)));
+		__m256d ssgn = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_srli_epi64(k, 1), 63));
+		__m256d csgn = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_srli_epi64(_mm256_add_epi64(k, _mm256_set1_epi64x(1)), 1), 63));
+		s = _mm256_xor_pd(_mm256_blendv_pd(ps, pc, odd), ssgn);
+		c = _mm256_xor_pd(_mm256_blendv_pd(pc, ps, odd), csgn);
+
+		// Arguments beyond the reduction go through libm
+		__m256d large = _mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), x), _mm256_set1_pd(SINCOS_LIMIT), _CMP_NLE_UQ);
+		if (!_mm256_testz_pd(large, large))
+		{
+			double lx[4], ls[4], lc[4];
+			_mm256_storeu_pd(lx, x);
+			_mm256_storeu_pd(ls, s);
+			_mm256_storeu_pd(lc, c);
+			for (unsigned l = 0; l < 4; l++)
+			{
+				if (!(std::fabs(lx[l]) <= SINCOS_LIMIT))
+				{
+					ls[l] = std::sin(lx[l]);
+					lc[l] = std::cos(lx[l]);
+				}
+			}
+			s = _mm256_loadu_pd(ls);
+			c = _mm256_loadu_pd(lc);
+		}
+	}
+
+	/**
+	 * Computes sinh x and cosh x, each within 2 ulp
+	 *
+	 * @param x  the arguments
+	 * @param sh sinh x (set)
+	 * @param ch cosh x (set)
+	 */
+	__attribute__((target("avx2,fma")))
+	inline void vsinhcosh(__m256d x, __m256d& sh, __m256d& ch)
+	{
+		// (e^|x| +- e^-|x|) / 2
+		const __m256d sign = _mm256_set1_pd(-0.0);
+		__m256d ax = _mm256_andnot_pd(sign, x);
+		__m256d e  = vexp(ax);
+		__m256d ie = _mm256_div_pd(_mm256_set1_pd(1), e);
+		ch = _mm256_mul_pd(_mm256_add_pd(e, ie), _mm256_set1_pd(0.5));
+		__m256d big = _mm256_mul_pd(_mm256_sub_pd(e, ie), _mm256_set1_pd(0.5));
+
+		// Below 1, where e^x - e^-x cancels, sinh x by its Taylor series to x^19
+		__m256d z = _mm256_mul_pd(ax, ax);
+		__m256d p = _mm256_set1_pd(1.0 / 121645100408832000.0);
+		p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 355687428096000.0));
+		p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 1307674368000.0));
+		p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 6227020800.0));
+		p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 39916800.0));
+		p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 362880.0));
+		p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 5040.0));
+		p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 120.0));
+		p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 6.0));
+		__m256d small = _mm256_fmadd_pd(_mm256_mul_pd(p, z), ax, ax);
+
+		// sinh is odd
+		sh = _mm256_blendv_pd(big, small, _mm256_cmp_pd(ax, _mm256_set1_pd(1), _CMP_LT_OQ));
+		sh = _mm256_or_pd(sh, _mm256_and_pd(sign, x));
+	}
+
+	/**
+	 * Returns log(1 + f) + lo for f from sqrt(2)/2 - 1 to sqrt(2) - 1 and
+	 * small lo, within 1 ulp (fdlibm's log kernel, which adds lo before the
+	 * last rounding)
+	 *
+	 * @param f  the arguments
+	 * @param lo the small terms to add
+	 *
+	 * @return log(1 + f) + lo
+	 */
+	__attribute__((target("avx2,fma")))
+	inline __m256d vlog1pKernel(__m256d f, __m256d lo)
+	{
+		__m256d hfsq = _mm256_mul_pd(_mm256_mul_pd(f, f), _mm256_set1_pd(0.5));
+		__m256d s  = _mm256_div_pd(f, _mm256_add_pd(_mm256_set1_pd(2), f));
+		__m256d z  = _mm256_mul_pd(s, s);
+		__m256d w  = _mm256_mul_pd(z, z);
+		__m256d t1 = _mm256_fmadd_pd(w, _mm256_set1_pd(1.531383769920937332e-01), _mm256_set1_pd(2.222219843214978396e-01));
+		t1 = _mm256_mul_pd(w, _mm256_fmadd_pd(w, t1, _mm256_set1_pd(3.999999999940941908e-01)));
+		__m256d t2 = _mm256_fmadd_pd(w, _mm256_set1_pd(1.479819860511658591e-01), _mm256_set1_pd(1.818357216161805012e-01));
+		t2 = _mm256_fmadd_pd(w, t2, _mm256_set1_pd(2.857142874366239149e-01));
+		t2 = _mm256_mul_pd(z, _mm256_fmadd_pd(w, t2, _mm256_set1_pd(6.666666666666735130e-01)));
+		__m256d R = _mm256_add_pd(t2, t1);
+		return _mm256_sub_pd(f, _mm256_sub_pd(hfsq, _mm256_fmadd_pd(s, _mm256_add_pd(hfsq, R), lo)));
+	}
+
+	/**
+	 * Returns log x for positive normal x, within 1 ulp
+	 *
+	 * @param x the arguments
+	 *
+	 * @return log x
+	 */
+	__attribute__((target("avx2,fma")))
+	inline __m256d vlog(__m256d x)
+	{
+		// x = 2^k m, sqrt(2)/2 <= m < sqrt(2) (moving the bits of m below sqrt(2)/2 up an octave)
+		__m256i bits = _mm256_castpd_si256(x);
+		__m256i top  = _mm256_add_epi64(bits, _mm256_set1_epi64x(0x00095f619980c433LL));
+		__m256i k    = _mm256_sub_epi64(_mm256_srli_epi64(top, 52), _mm256_set1_epi64x(1023));
+		__m256i mant = _mm256_add_epi64(_mm256_and_si256(top, _mm256_set1_epi64x(0x000fffffffffffffLL)),
+			_mm256_set1_epi64x(0x3fe6a09e667f3bcdLL));
+		__m256d f    = _mm256_sub_pd(_mm256_castsi256_pd(mant), _mm256_set1_pd(1));
+
+		// k as a double (it fits in the low 32 bits)
+		const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+		__m256d dk = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(k, _mm256_castpd_si256(magic))), magic);
+
+		// log x = k ln 2 + log(1 + f) (ln 2 split so that k ln2hi is exact)
+		__m256d hi = _mm256_mul_pd(dk, _mm256_set1_pd(6.93147180369123816490e-01));
+		__m256d lo = _mm256_mul_pd(dk, _mm256_set1_pd(1.90821492927058770002e-10));
+		return _mm256_add_pd(hi, vlog1pKernel(f, lo));
+	}
+
+	/**
+	 * Returns atan2(y, x) for finite x and y, within 2 ulp (Cephes' atan,
+	 * reduced to [0, 1])
+	 *
+	 * @param y the ordinates
+	 * @param x the abscissas
+	 *
+	 * @return the angle of (x, y), from -pi to pi
+	 */
+	__attribute__((target("avx2,fma")))
+	inline __m256d vatan2(__m256d y, __m256d x)
+	{
+		// a = min(|x|, |y|) / max(|x|, |y|) (0 at the origin)
+		const __m256d sign = _mm256_set1_pd(-0.0);
+		__m256d ax = _mm256_andnot_pd(sign, x), ay = _mm256_andnot_pd(sign, y);
+		__m256d hi = _mm256_max_pd(ax, ay), lo = _mm256_min_pd(ax, ay);
+		__m256d zero = _mm256_cmp_pd(hi, _mm256_setzero_pd(), _CMP_EQ_OQ);
+		__m256d a = _mm256_andnot_pd(zero, _mm256_div_pd(lo, _mm256_blendv_pd(hi, _mm256_set1_pd(1), zero)));
+
+		// Above 0.66, atan a = pi/4 + atan((a - 1) / (a + 1))
+		__m256d upper = _mm256_cmp_pd(a, _mm256_set1_pd(0.66), _CMP_GT_OQ);
+		__m256d t  = _mm256_blendv_pd(a, _mm256_div_pd(_mm256_sub_pd(a, _mm256_set1_pd(1)), _mm256_add_pd(a, _mm256_set1_pd(1))), upper);
+		__m256d y0 = _mm256_and_pd(upper, _mm256_set1_pd(7.85398163397448309616e-01));
+		__m256d m0 = _mm256_and_pd(upper, _mm256_set1_pd(3.061616997868382943065e-17));
+
+		// atan t = t + t^3 P(t^2) / Q(t^2)
+		__m256d z = _mm256_mul_pd(t, t);
+		__m256d p = _mm256_set1_pd(-8.750608600031904122785e-01);
+		p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(-1.615753718733365076637e+01));
+		p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(-7.500855792314704667340e+01));
+		p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(-1.228866684490136173410e+02));
+		p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(-6.485021904942025371773e+01));
+		__m256d q = _mm256_add_pd(z, _mm256_set1_pd(2.485846490142306297962e+01));
+		q = _mm256_fmadd_pd(q, z, _mm256_set1_pd(1.650270098316988542046e+02));
+		q = _mm256_fmadd_pd(q, z, _mm256_set1_pd(4.328810604912902668951e+02));
+		q = _mm256_fmadd_pd(q, z, _mm256_set1_pd(4.853903996359136964868e+02));
+		q = _mm256_fmadd_pd(q, z, _mm256_set1_pd(1.945506571482613964425e+02));
+		__m256d r = _mm256_fmadd_pd(_mm256_mul_pd(t, z), _mm256_div_pd(p, q), t);
+		r = _mm256_add_pd(y0, _mm256_add_pd(r, m0));
+
+		// Unfold the octant: pi/2 - r if |y| > |x|, then pi - r if x < 0, then the sign of y
+		const __m256d pio2hi = _mm256_set1_pd(1.57079632679489655800e+00), pio2lo = _mm256_set1_pd(6.12323399573676603587e-17);
+		r = _mm256_blendv_pd(r, _mm256_add_pd(pio2hi, _mm256_sub_pd(pio2lo, r)), _mm256_cmp_pd(ay, ax, _CMP_GT_OQ));
+		r = _mm256_blendv_pd(r, _mm256_add_pd(_mm256_add_pd(pio2hi, pio2hi), _mm256_sub_pd(_mm256_add_pd(pio2lo, pio2lo), r)), x);
+		return _mm256_or_pd(r, _mm256_and_pd(sign, y));
+	}
+
+	/**
+	 * Computes e^z = e^x (cos y + i sin y), each component within 3 ulp
+	 *
+	 * @param x  the real components of z
+	 * @param y  the imaginary components of z
+	 * @param re the real components of e^z (set)
+	 * @param im the imaginary components of e^z (set)
+	 */
+	__attribute__((target("avx2,fma")))
+	inline void vcexp(__m256d x, __m256d y, __m256d& re, __m256d& im)
+	{
+		__m256d s, c, e = vexp(x);
+		vsincos(y, s, c);
+		re = _mm256_mul_pd(e, c);
+		im = _mm256_mul_pd(e, s);
+	}
+
+	/**
+	 * Computes sin z = sin x cosh y + i cos x sinh y, each component within
+	 * 3.5 ulp
+	 *
+	 * @param x  the real components of z
+	 * @param y  the imaginary components of z
+	 * @param re the real components of sin z (set)
+	 * @param im the imaginary components of sin z (set)
+	 */
+	__attribute__((target("avx2,fma")))
+	inline void vcsin(__m256d x, __m256d y, __m256d& re, __m256d& im)
+	{
+		__m256d s, c, sh, ch;
+		vsincos(x, s, c);
+		vsinhcosh(y, sh, ch);
+		re = _mm256_mul_pd(s, ch);
+		im = _mm256_mul_pd(c, sh);
+	}
+
+	/**
+	 * Computes cos z = cos x cosh y - i sin x sinh y, each component within
+	 * 3.5 ulp
+	 *
+	 * @param x  the real components of z
+	 * @param y  the imaginary components of z
+	 * @param re the real components of cos z (set)
+	 * @param im the imaginary components of cos z (set)
+	 */
+	__attribute__((target("avx2,fma")))
+	inline void vccos(__m256d x, __m256d y, __m256d& re, __m256d& im)
+	{
+		__m256d s, c, sh, ch;
+		vsincos(x, s, c);
+		vsinhcosh(y, sh, ch);
+		re = _mm256_mul_pd(c, ch);
+		im = _mm256_xor_pd(_mm256_mul_pd(s, sh), _mm256_set1_pd(-0.0));
+	}
+
+	/**
+	 * Computes the principal log z = log |z| + i arg z of finite non-zero z,
+	 * each component within 2 ulp.
+	 * Near the unit circle, log |z| is taken as log(1 + (x^2 + y^2 - 1))
+	 * with x^2 + y^2 - 1 summed exactly, so it keeps its relative accuracy
+	 * as it goes to zero.
+	 *
+	 * @param x  the real components of z
+	 * @param y  the imaginary components of z
+	 * @param re the real components of log z (set)
+	 * @param im the imaginary components of log z (set)
+	 */
+	__attribute__((target("avx2,fma")))
+	inline void vclog(__m256d x, __m256d y, __m256d& re, __m256d& im)
+	{
+		// Scale far from 1 by 2^-k, k the exponent of max(|x|, |y|), so that
+		// x^2 + y^2 neither overflows nor underflows (taken in two halves)
+		const __m256d sign = _mm256_set1_pd(-0.0);
+		const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+		__m256d m  = _mm256_max_pd(_mm256_andnot_pd(sign, x), _mm256_andnot_pd(sign, y));
+		__m256d extreme = _mm256_or_pd(_mm256_cmp_pd(m, _mm256_set1_pd(0x1p500), _CMP_GT_OQ),
+			_mm256_cmp_pd(m, _mm256_set1_pd(0x1p-500), _CMP_LT_OQ));
+		__m256i e  = _mm256_sub_epi64(_mm256_srli_epi64(_mm256_castpd_si256(m), 52), _mm256_set1_epi64x(1023));
+		__m256d k  = _mm256_and_pd(extreme, _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(e, _mm256_castpd_si256(magic))), magic));
+		__m256d half = _mm256_floor_pd(_mm256_mul_pd(k, _mm256_set1_pd(-0.5)));
+		__m256d sx = _mm256_mul_pd(_mm256_mul_pd(x, vpow2(half)), vpow2(_mm256_sub_pd(_mm256_xor_pd(k, sign), half)));
+		__m256d sy = _mm256_mul_pd(_mm256_mul_pd(y, vpow2(half)), vpow2(_mm256_sub_pd(_mm256_xor_pd(k, sign), half)));
+
+		// log |z| = k ln 2 + log(x^2 + y^2) / 2, with x^2 + y^2 = rh + rl
+		// summed to twice the precision, and log(rh + rl) = log rh + rl / rh
+		__m256d sxx = _mm256_mul_pd(sx, sx), syy = _mm256_mul_pd(sy, sy);
+		__m256d rh  = _mm256_add_pd(sxx, syy);
+		__m256d rv  = _mm256_sub_pd(rh, sxx);
+		__m256d rl  = _mm256_add_pd(_mm256_add_pd(_mm256_sub_pd(sxx, _mm256_sub_pd(rh, rv)), _mm256_sub_pd(syy, rv)),
+			_mm256_add_pd(_mm256_fmsub_pd(sx, sx, sxx), _mm256_fmsub_pd(sy, sy, syy)));
+		__m256d far = _mm256_fmadd_pd(k, _mm256_set1_pd(6.93147180559945286227e-01),
+			_mm256_mul_pd(_mm256_add_pd(vlog(rh), _mm256_div_pd(rl, rh)), _mm256_set1_pd(0.5)));
+
+		// x^2 + y^2 - 1 as the exact sum of x^2, y^2 and -1 (each square split
+		// into two doubles), accumulated largest first with error-free sums
+		__m256d xx = _mm256_mul_pd(x, x), xl = _mm256_fmsub_pd(x, x, xx);
+		__m256d yy = _mm256_mul_pd(y, y), yl = _mm256_fmsub_pd(y, y, yy);
+		__m256d big = _mm256_max_pd(xx, yy), small = _mm256_min_pd(xx, yy);
+		__m256d d  = _mm256_sub_pd(big, _mm256_set1_pd(1));
+		__m256d v  = _mm256_sub_pd(d, big);
+		__m256d e1 = _mm256_sub_pd(_mm256_sub_pd(big, _mm256_sub_pd(d, v)), _mm256_add_pd(_mm256_set1_pd(1), v));
+		__m256d t  = _mm256_add_pd(d, small);
+		v = _mm256_sub_pd(t, d);
+		__m256d e2 = _mm256_add_pd(_mm256_sub_pd(d, _mm256_sub_pd(t, v)), _mm256_sub_pd(small, v));
+		__m256d f  = _mm256_add_pd(t, _mm256_add_pd(_mm256_add_pd(e1, e2), _mm256_add_pd(xl, yl)));
+		__m256d near = _mm256_mul_pd(vlog1pKernel(f, _mm256_setzero_pd()), _mm256_set1_pd(0.5));
+
+		// Near the unit circle (f within the range of the log kernel)
+		__m256d inside = _mm256_and_pd(_mm256_cmp_pd(f, _mm256_set1_pd(-2.928932188134524755992e-01), _CMP_GT_OQ),
+			_mm256_cmp_pd(f, _mm256_set1_pd(4.142135623730950488017e-01), _CMP_LT_OQ));
+		re = _mm256_blendv_pd(far, near, inside);
+		im = vatan2(y, x);
+	}
+}
+
+#endif
@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/attractor.h"
+#include "Fractal/kernel.h"
+
+// Libraries being used
+#include <cmath>
+
+// Namespaces being used
+using namespace std;
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	// Number of Newton's method steps taken to refine a cycle point
+	static const unsigned NEWTON_STEPS = 64;
+
+	// Number of points sampled on the rim of the capture disk
+	static const unsigned RIM_SAMPLES = 64;
+
+	// Smallest capture disk worth checking for
+	static const double MIN_RADIUS = 1e-12;
+
+	/**
+	 * Creates an empty Attractor
+	 */
+	Attractor::Attractor(): point(0), period(0), multiplier(0), radius(0) {}
+
+	/**
+	 * Iterates z = z^2 + c the given number of times, also returning the
+	 * derivative of the result with respect to z
+	 *
+	 * @param z      the starting point
+	 * @param c      the julia set complex constant
+	 * @param period the number of iterations
+	 * @param deriv  the derivative of the result (set)
+	 *
+	 * @return the point after the given number of iterations
+	 */
+	static complex<double> iterate(complex<double> z, const complex<double>& c, unsigned period, complex<double>& deriv)
+	{
+		deriv = 1;
+		for (unsigned i = 0; i < period; i++)
+		{
+			deriv *= 2.0*z;
+			z      = z*z + c;
+		}
+		return z;
+	}
+
+	/**
+	 * Returns true if every sampled point on the rim of the disk of the given
+	 * radius around the cycle point lands within half the radius of it after
+	 * one period (so the whole disk is drawn into the cycle)
+	 *
+	 * @param attractor the attracting cycle
+	 * @param c         the julia set complex constant
+	 * @param radius    the radius of the disk
+	 *
+	 * @return true if the disk is drawn into the cycle
+	 */
+	static bool captures(const Attractor& attractor, const complex<double>& c, double radius)
+	{
+		complex<double> z, deriv;
+		for (unsigned i = 0; i < RIM_SAMPLES; i++)
+		{
+			z = attractor.point + polar(radius, 2*M_PI*i / RIM_SAMPLES);
+			z = iterate(z, c, attractor.period, deriv);
+			if (!(abs(z - attractor.point) < 0.5*radius)) return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Finds the attracting cycle of z = z^2 + c, if any. The critical orbit
+	 * (starting at zero) is drawn into every attracting cycle, so it is iterated
+	 * until it settles, its period is found and refined with Newton's method,
+	 * and the disk around the cycle point is shrunk until points on its rim
+	 * land well inside it after one period.
+	 *
+	 * @param c         the julia set complex constant
+	 * @param attractor the attracting cycle (set if one is found)
+	 *
+	 * @return true if z = z^2 + c has an attracting cycle
+	 */
+	bool findAttractor(const complex<double>& c, Attractor& attractor)
+	{
+		// Let the critical orbit settle (no cycle if it goes to infinity)
+		attractor = Attractor();
+		complex<double> z = 0;
+		for (unsigned i = 0; i < ATTRACTOR_SETTLE; i++)
+		{
+			z = z*z + c;
+			if (norm(z) >= BAILOUT) return false;
+		}
+
+		// Refine each period with Newton's method on f^period(z) - z (z^2 + c has at
+		// most one attracting cycle, so the first one found is the one)
+		for (unsigned period = 1; period <= ATTRACTOR_PERIOD; period++)
+		{
+			complex<double> w = z, deriv;
+			for (unsigned i = 0; i < NEWTON_STEPS; i++)
+			{
+				complex<double> step = (iterate(w, c, period, deriv) - w) / (deriv - 1.0);
+				w -= step;
+				if (abs(step) < 1e-15 * (1 + abs(w))) break;
+			}
+
+			// The cycle only attracts if it closes and its multiplier is less than one
+			complex<double> back = iterate(w, c, period, deriv);
+			if (!(abs(back - w) < 1e-12 * (1 + abs(w)) && abs(deriv) < 1)) continue;
+			attractor.point      = w;
+			attractor.period     = period;
+			attractor.multiplier = deriv;
+			break;
+		}
+		if (attractor.period == 0) return false;
+
+		// Shrink the capture disk until it is drawn into the cycle
+		for (double radius = 1; radius >= MIN_RADIUS; radius *= 0.5)
+		{
+			if (captures(attractor, c, radius))
+			{
+				attractor.radius = radius;
+				return true;
+			}
+		}
+		return false;
+	}
+}
@@ -0,0 +1,282 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/bigfloat.h"
+
+// Libraries being used
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
+// Namespaces being used
+using namespace std;
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	// Bits held by each limb
+	static const unsigned LIMB_BITS = 32;
+
+	// Mask of the bits held by each limb
+	static const unsigned long long LIMB_MASK = 0xFFFFFFFFull;
+
+	// Guard bits kept beyond the smallest distance that must be resolved
+	static const unsigned GUARD_BITS = 64;
+
+	/**
+	 * Creates a zero BigFloat with the given number of limbs
+	 *
+	 * @param limbs the number of limbs (one integer limb and the fraction)
+	 */
+	BigFloat::BigFloat(unsigned limbs): m_negative(false), m_limbs(limbs, 0) {}
+
+	/**
+	 * Creates a BigFloat with the given number of limbs equal to the given double
+	 *
+	 * @param x     the double
+	 * @param limbs the number of limbs (one integer limb and the fraction)
+	 */
+	BigFloat::BigFloat(double x, unsigned limbs): m_negative(x < 0), m_limbs(limbs, 0)
+	{
+		// Peel off 32 bits at a time (exact, as a double has at most 53)
+		x = fabs(x);
+		for (unsigned i = 0; i < limbs && x != 0; i++)
+		{
+			m_limbs[i] = (unsigned)floor(x);
+			x = ldexp(x - m_limbs[i], LIMB_BITS);
+		}
+	}
+
+	/**
+	 * Creates a BigFloat with the given number of limbs from the given decimal
+	 * string (such as "-0.75", "1e-20" or a 100 digit offset)
+	 *
+	 * @param str   the decimal string
+	 * @param limbs the number of limbs (one integer limb and the fraction)
+	 */
+	BigFloat::BigFloat(const string& str, unsigned limbs): m_negative(false), m_limbs(limbs, 0)
+	{
+		// Sign
+		unsigned i = 0;
+		while (i < str.size() && isspace(str[i])) i++;
+		bool negative = i < str.size() && str[i] == '-';
+		if (i < str.size() && (str[i] == '-' || str[i] == '+')) i++;
+
+		// Digits (point is the number of digits before the decimal point)
+		string digits;
+		int point = -1;
+		for (; i < str.size(); i++)
+		{
+			if (str[i] == '.' && point < 0)
+				point = digits.size();
+			else if (isdigit(str[i]))
+				digits += str[i];
+			else
+				break;
+		}
+		if (point < 0) point = digits.size();
+
+		// Exponent moves the decimal point
+		if (i < str.size() && (str[i] == 'e' || str[i] == 'E'))
+			point += atoi(str.c_str() + i + 1);
+
+		// Fraction digits, least significant first (each is added then shifted down)
+		for (int d = (int)digits.size() - 1; d >= 0 && d >= point; d--)
+		{
+			m_limbs[0] += digits[d] - '0';
+			divide(10);
+		}
+
+		// Leading zeros of a fraction below 0.1
+		for (int d = point; d < 0; d++)
+			divide(10);
+
+		// Integer digits (past the end of the digits they are trailing zeros)
+		unsigned integer = 0;
+		for (int d = 0; d < point; d++)
+			integer = 10*integer + (d < (int)digits.size() ? digits[d] - '0' : 0);
+		m_limbs[0] = integer;
+		m_negative = negative;
+	}
+
+	/**
+	 * Returns the number rounded to a double
+	 *
+	 * @return the number rounded to a double
+	 */
+	double BigFloat::toDouble() const
+	{
+		// Three limbs hold more bits than a double
+		double x = 0;
+		for (unsigned i = 0; i < m_limbs.size() && i < 3; i++)
+			x += ldexp((double)m_limbs[i], -(int)(i*LIMB_BITS));
+		return m_negative ? -x : x;
+	}
+
+	/**
+	 * Divides this number by the given small integer
+	 *
+	 * @param divisor the divisor
+	 */
+	void BigFloat::divide(unsigned divisor)
+	{
+		// Long division, most significant limb first
+		unsigned long long remainder = 0, current;
+		for (unsigned i = 0; i < m_limbs.size(); i++)
+		{
+			current     = (remainder << LIMB_BITS) | m_limbs[i];
+			m_limbs[i]  = (unsigned)(current / divisor);
+			remainder   = current % divisor;
+		}
+	}
+
+	/**
+	 * Returns true if the magnitude of this number is less than that of the other
+	 *
+	 * @param other the other number
+	 *
+	 * @return true if the magnitude of this number is less than that of the other
+	 */
+	bool BigFloat::lessMagnitude(const BigFloat& other) const
+	{
+		for (unsigned i = 0; i < m_limbs.size(); i++)
+			if (m_limbs[i] != other.m_limbs[i])
+				return m_limbs[i] < other.m_limbs[i];
+		return false;
+	}
+
+	/**
+	 * Adds the magnitude of the other number to the magnitude of this number
+	 *
+	 * @param other the other number
+	 */
+	void BigFloat::addMagnitude(const BigFloat& other)
+	{
+		unsigned long long carry = 0;
+		for (unsigned i = m_limbs.size(); i-- > 0;)
+		{
+			carry     += (unsigned long long)m_limbs[i] + other.m_limbs[i];
+			m_limbs[i] = (unsigned)(carry & LIMB_MASK);
+			carry    >>= LIMB_BITS;
+		}
+	}
+
+	/**
+	 * Subtracts the magnitude of the other number from the magnitude of this
+	 * number (which must be at least as large)
+	 *
+	 * @param other the other number
+	 */
+	void BigFloat::subMagnitude(const BigFloat& other)
+	{
+		long long borrow = 0, difference;
+		for (unsigned i = m_limbs.size(); i-- > 0;)
+		{
+			difference = (long long)m_limbs[i] - other.m_limbs[i] - borrow;
+			borrow     = difference < 0;
+			m_limbs[i] = (unsigned)(difference + (borrow << LIMB_BITS));
+		}
+	}
+
+	/**
+	 * Returns the sum of this number and the other
+	 *
+	 * @param other the other number
+	 *
+	 * @return the sum of this number and the other
+	 */
+	BigFloat BigFloat::operator+(const BigFloat& other) const
+	{
+		// Same signs add, different signs subtract the smaller magnitude
+		BigFloat sum(*this);
+		if (m_negative == other.m_negative)
+			sum.addMagnitude(other);
+		else if (lessMagnitude(other))
+		{
+			sum = other;
+			sum.subMagnitude(*this);
+		}
+		else
+			sum.subMagnitude(other);
+		return sum;
+	}
+
+	/**
+	 * Returns the difference of this number and the other
+	 *
+	 * @param other the other number
+	 *
+	 * @return the difference of this number and the other
+	 */
+	BigFloat BigFloat::operator-(const BigFloat& other) const
+	{
+		BigFloat negated(other);
+		negated.m_negative = !other.m_negative;
+		return *this + negated;
+	}
+
+	/**
+	 * Returns the product of this number and the other (truncated to the
+	 * precision of this number)
+	 *
+	 * @param other the other number
+	 *
+	 * @return the product of this number and the other
+	 */
+	BigFloat BigFloat::operator*(const BigFloat& other) const
+	{
+		// Column sums (each limb product adds its low half to its own column
+		// and its high half to the next more significant one, with one guard column)
+		unsigned size = m_limbs.size();
+		vector<unsigned long long> columns(size + 1, 0);
+		unsigned long long product;
+		for (unsigned i = 0; i < size; i++)
+		{
+			for (unsigned j = 0; i + j <= size && j < size; j++)
+			{
+				product = (unsigned long long)m_limbs[i] * other.m_limbs[j];
+				columns[i+j] += product & LIMB_MASK;
+				if (i + j > 0) columns[i+j-1] += product >> LIMB_BITS;
+			}
+		}
+
+		// Carry from the least significant column up
+		BigFloat result(size);
+		unsigned long long carry = 0;
+		for (unsigned k = size + 1; k-- > 0;)
+		{
+			carry += columns[k];
+			if (k < size) result.m_limbs[k] = (unsigned)(carry & LIMB_MASK);
+			carry >>= LIMB_BITS;
+		}
+		result.m_negative = m_negative != other.m_negative;
+		return result;
+	}
+
+	/**
+	 * Returns the number of limbs a BigFloat needs to resolve the given distance
+	 *
+	 * @param spacing the smallest distance that must be resolved
+	 *
+	 * @return the number of limbs needed
+	 */
+	unsigned bigFloatLimbs(double spacing)
+	{
+		// One integer limb and enough fraction limbs for the distance and the guard bits
+		double bits = -log2(spacing);
+		if (bits < 0) bits = 0;
+		return 1 + ((unsigned)bits + GUARD_BITS + LIMB_BITS - 1) / LIMB_BITS;
+	}
+}
@@ -90,23 +90,23 @@ namespace fractal
 		 */
 		ColorGradientRGB::ColorGradientRGB(ColorRGB first, ColorRGB last)
 		{
-			red   = (last.red   - first.red)   / ((double)MAX_ITER);
-			green = (last.green - first.green) / ((double)MAX_ITER);
-			blue  = (last.blue  - first.blue)  / ((double)MAX_ITER);
+			red   = last.red   - first.red;
+			green = last.green - first.green;
+			blue  = last.blue  - first.blue;
 
 		}
 
 		/**
 		 * Computes the gradient value at the given point in the space
 		 *
-		 * @param point the point in the gradient space
+		 * @param point the point in the gradient space (0 to 1)
 		 */
-		ColorGradientRGB ColorGradientRGB::operator*(unsigned iterations) const
+		ColorGradientRGB ColorGradientRGB::operator*(double point) const
 		{
 			return ColorGradientRGB(
-				red*iterations,
-				green*iterations,
-				blue*iterations
+				red*point,
+				green*point,
+				blue*point
 			);
 		}
 	}
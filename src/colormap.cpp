@@ -70,12 +70,13 @@ namespace fractal
 		 * Maps the given number of iterations to a given color
 		 *
 		 * @param iterations the iterations being mapped
+		 * @param maxIter    the iteration limit the iterations are normalised to
 		 *
 		 * @return the color calculated from the iterations
 		 */
-		ColorRGB GradientMapRGB::color(unsigned iterations) const
+		ColorRGB GradientMapRGB::color(unsigned iterations, unsigned maxIter) const
 		{
-			return m_start + m_gradient*iterations;
+			return m_start + m_gradient*(iterations / (double)maxIter);
 		}
 
 		/**
@@ -119,13 +120,14 @@ namespace fractal
 		 * Maps the given number of iterations to a given color
 		 *
 		 * @param iterations the iterations being mapped
+		 * @param maxIter    the iteration limit the iterations are normalised to
 		 *
 		 * @return the color calculated from the iterations
 		 */
-		ColorRGB RainbowMapRGB::color(unsigned iterations) const
+		ColorRGB RainbowMapRGB::color(unsigned iterations, unsigned maxIter) const
 		{
 			// Change iterations space to radians
-			double angle = iterations / ((double)MAX_ITER) * (2*M_PI);
+			double angle = iterations / ((double)maxIter) * (2*M_PI);
 
 			// Generate color
 			return ColorRGB(
@@ -0,0 +1,71 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/cpu.h"
+
+// Libraries being used
+#include <cpuid.h>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * Returns the register state the operating system saves on context switch
+	 *
+	 * @return the extended control register (XCR0)
+	 */
+	static unsigned long long xgetbv()
+	{
+		unsigned lo, hi;
+		__asm__ __volatile__ ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+		return ((unsigned long long)hi << 32) | lo;
+	}
+
+	/**
+	 * Detects the features of this cpu
+	 */
+	CpuFeatures::CpuFeatures():
+	sse2(false), avx2(false), fma(false), avx512f(false), bmi2(false)
+	{
+		unsigned a, b, c, d;
+
+		// Basic features
+		if (!__get_cpuid(1, &a, &b, &c, &d)) return;
+		sse2 = d & bit_SSE2;
+
+		// The os has to save the ymm (and zmm) registers for AVX (and AVX-512)
+		unsigned long long xcr0 = (c & bit_OSXSAVE) ? xgetbv() : 0;
+		bool ymm = (c & bit_AVX) && (xcr0 & 0x06) == 0x06;
+		bool zmm = ymm && (xcr0 & 0xe0) == 0xe0;
+		fma = ymm && (c & bit_FMA);
+
+		// Extended features
+		if (!__get_cpuid_count(7, 0, &a, &b, &c, &d)) return;
+		avx2    = ymm && (b & bit_AVX2);
+		avx512f = zmm && (b & bit_AVX512F);
+		bmi2    = b & bit_BMI2;
+	}
+
+	/**
+	 * Returns the features of this cpu (detected once, at first call)
+	 *
+	 * @return the features of this cpu
+	 */
+	const CpuFeatures& getCpuFeatures()
+	{
+		static CpuFeatures features;
+		return features;
+	}
+}
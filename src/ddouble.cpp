@@ -0,0 +1,88 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/ddouble.h"
+
+// Libraries being used
+#include <cctype>
+#include <cstdlib>
+
+// Namespaces being used
+using namespace std;
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * Returns ten to the given power as a ddouble
+	 *
+	 * @param exp the power of ten
+	 *
+	 * @return ten to the given power
+	 */
+	static ddouble powerOfTen(int exp)
+	{
+		// Exponentiation by squaring
+		ddouble result(1), base(10);
+		for (unsigned n = exp < 0 ? -exp : exp; n; n >>= 1)
+		{
+			if (n & 1) result = result * base;
+			base = sqr(base);
+		}
+		return exp < 0 ? ddouble(1) / result : result;
+	}
+
+	/**
+	 * Parses a ddouble from the given decimal string (such as "-0.75",
+	 * "1e-20" or a 32 digit offset), keeping every digit a ddouble can hold
+	 *
+	 * @param str the decimal string
+	 *
+	 * @return the ddouble parsed from the string (zero if it is not a number)
+	 */
+	ddouble parseDDouble(const string& str)
+	{
+		// Sign
+		unsigned i = 0;
+		while (i < str.size() && isspace(str[i])) i++;
+		bool negative = i < str.size() && str[i] == '-';
+		if (i < str.size() && (str[i] == '-' || str[i] == '+')) i++;
+
+		// Digits (the decimal point moves the exponent)
+		ddouble value;
+		int exp = 0;
+		bool point = false;
+		for (; i < str.size(); i++)
+		{
+			if (str[i] == '.' && !point)
+				point = true;
+			else if (isdigit(str[i]))
+			{
+				value = value * ddouble(10) + ddouble(str[i] - '0');
+				if (point) exp--;
+			}
+			else
+				break;
+		}
+
+		// Exponent
+		if (i < str.size() && (str[i] == 'e' || str[i] == 'E'))
+			exp += atoi(str.c_str() + i + 1);
+
+		// Scale and sign
+		if (exp) value = exp < 0 ? value / powerOfTen(-exp) : value * powerOfTen(exp);
+		return negative ? -value : value;
+	}
+}
@@ -0,0 +1,84 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/fixed.h"
+
+// Libraries being used
+#include <cctype>
+#include <cstdlib>
+
+// Namespaces being used
+using namespace std;
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * Parses a fixed128 from the given decimal string (such as "-0.75",
+	 * "1e-20" or a 40 digit offset), keeping every bit a fixed128 can hold
+	 *
+	 * @param str the decimal string
+	 *
+	 * @return the fixed128 parsed from the string (zero if it is not a number,
+	 *         saturated outside [-8, 8))
+	 */
+	fixed128 parseFixed(const string& str)
+	{
+		// Sign
+		unsigned i = 0;
+		while (i < str.size() && isspace(str[i])) i++;
+		bool negative = i < str.size() && str[i] == '-';
+		if (i < str.size() && (str[i] == '-' || str[i] == '+')) i++;
+
+		// Digits (point is the number of digits before the decimal point)
+		string digits;
+		int point = -1;
+		for (; i < str.size(); i++)
+		{
+			if (str[i] == '.' && point < 0)
+				point = digits.size();
+			else if (isdigit(str[i]))
+				digits += str[i];
+			else
+				break;
+		}
+		if (point < 0) point = digits.size();
+
+		// Exponent moves the decimal point
+		if (i < str.size() && (str[i] == 'e' || str[i] == 'E'))
+			point += atoi(str.c_str() + i + 1);
+
+		// Fraction digits, least significant first (each is added then shifted down)
+		const unsigned __int128 one = (unsigned __int128)1 << FIXED_FRACTION_BITS;
+		unsigned __int128 magnitude = 0;
+		for (int d = (int)digits.size() - 1; d >= 0 && d >= point; d--)
+			magnitude = (magnitude + (digits[d] - '0') * one) / 10;
+
+		// Leading zeros of a fraction below 0.1
+		for (int d = point; d < 0 && magnitude; d++)
+			magnitude /= 10;
+
+		// Integer digits (past the end of the digits they are trailing zeros)
+		unsigned integer = 0;
+		for (int d = 0; d < point && integer < 8; d++)
+			integer = 10*integer + (d < (int)digits.size() ? digits[d] - '0' : 0);
+
+		// Saturate beyond the range
+		if (integer >= 8)
+			return fixed128(negative ? -8.0 : 8.0);
+		magnitude += integer * one;
+		return fixed128::fromRaw(negative ? -(__int128)magnitude : (__int128)magnitude);
+	}
+}
@@ -9,9 +9,15 @@
 
 // Headers being used
 #include "Fractal/fractal.h"
+#include "Fractal/interior.h"
+#include "Fractal/kernel.h"
+#include "Fractal/threadpool.h"
+#include "Fractal/tile.h"
 
 // Libraries being used
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 // Libraries being used
 using namespace std;
@@ -26,21 +32,47 @@ using namespace fractal::colormap;
  */
 namespace fractal
 {
+	// How the pixels of each tile are picked for iterating
+	static RenderMode mode = BRUTE_FORCE_MODE;
+
+	// Render mode names
+	static const char* modeNames[] = { "brute-force", "subdivide", "trace" };
+
+	// True if mirrored pixels are copied instead of being iterated
+	static bool symmetry = true;
+
+	// Largest distance (in pixels) of the mirror axis from a pixel line (or of
+	// the mirror point from a pixel) for pixels to be mirrored onto pixels
+	static const double MIRROR_TOLERANCE = 1e-6;
+
+	// Pixels of the mirrored region checked before mirroring, at least half
+	// of which must line up exactly with their partners
+	static const unsigned MIRROR_SAMPLES = 64;
+
+	// Farthest distance (in pixels, across and down) of an iterated pixel
+	// that a traced pixel is compared with
+	static const unsigned TRACE_REACH = 2;
+
+	// Spacing (in pixels, across and down) of the filled pixels iterated to
+	// check a traced fill
+	static const unsigned TRACE_CHECK = 4;
+
 	/**
 	 * Computes the JuliaSet algorithm of the given complex numbers
 	 *
-	 * @param z the complex number to check
-	 * @param c the constant complex number
+	 * @param z       the complex number to check
+	 * @param c       the constant complex number
+	 * @param maxIter the iteration limit
 	 * 
 	 * @return the number of the iterations before infinity
 	 */
-	unsigned juliaSetAlgorithm(complex<double>& z, const complex<double>& c)
+	unsigned juliaSetAlgorithm(complex<double>& z, const complex<double>& c, unsigned maxIter)
 	{
 		// Iterations at this point
 		unsigned n;
 
 		// Iterative process
-		for (n = 0; n < MAX_ITER; n++)
+		for (n = 0; n < maxIter; n++)
 		{
 			// Iteration function
 			z = pow(z, 2) + c;
@@ -56,11 +88,12 @@ namespace fractal
 	/**
 	 * Computes the Mandelbrot set algorithm of the given complex numbers
 	 *
-	 * @param c the complex number to check
+	 * @param c       the complex number to check
+	 * @param maxIter the iteration limit
 	 * 
 	 * @return the number of the iterations before infinity
 	 */
-	unsigned mandelbrotSetAlgorithm(std::complex<double>& c)
+	unsigned mandelbrotSetAlgorithm(std::complex<double>& c, unsigned maxIter)
 	{
 		// Iterations at this point
 		unsigned n;
@@ -69,7 +102,7 @@ namespace fractal
 		complex<double>z;
 
 		// Iterative process
-		for (n = 0; n < MAX_ITER; ++n)
+		for (n = 0; n < maxIter; ++n)
 		{
 			// Iteration function
 			z = pow(z, 2) + c;
@@ -83,37 +116,919 @@ namespace fractal
 	}
 
 	/**
-	 * Generates a Juliaset Image in the given object with the given complex constant
+	 * A symmetry of the image, under which every pixel of a region maps to
+	 * the conjugate (Mandelbrot set) or the negative (Julia set) of the point
+	 * of its partner pixel outside the region. Partners are found by
+	 * flipping x about kx/2, y about ky/2, or both.
 	 *
-	 * @param image the image object to generate the Juliaset in
-	 * @param c     the complex constant being used
-	 * @param trans the image configuration
-	 * @param map   the colormap being used
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct Mirror
+	{
+		/**
+		 * The pixels copied from their partners
+		 */
+		Tile region;
+
+		/**
+		 * True if partners map to conjugates (false if to negatives)
+		 */
+		bool conjugate;
+
+		/**
+		 * True if partners are found by flipping x
+		 */
+		bool flipX;
+
+		/**
+		 * True if partners are found by flipping y
+		 */
+		bool flipY;
+
+		/**
+		 * Twice the x coord of the axis (or point) x is flipped about
+		 */
+		long kx;
+
+		/**
+		 * Twice the y coord of the axis (or point) y is flipped about
+		 */
+		long ky;
+
+		/**
+		 * The width of the image
+		 */
+		unsigned width;
+
+		/**
+		 * The iterations of every pixel rendered outside the region
+		 */
+		vector<unsigned> counts;
+
+		/**
+		 * The precision every pixel outside the region was rendered in
+		 */
+		vector<unsigned char> precisions;
+
+		/**
+		 * Finds the partner of the given pixel
+		 *
+		 * @param x  the x coord of the pixel
+		 * @param y  the y coord of the pixel
+		 * @param px the x coord of the partner (set)
+		 * @param py the y coord of the partner (set)
+		 */
+		void partner(unsigned x, unsigned y, unsigned& px, unsigned& py) const
+		{
+			px = flipX ? kx - x : x;
+			py = flipY ? ky - y : y;
+		}
+	};
+
+	/**
+	 * Renders one tile of a Julia or Mandelbrot set image
 	 *
-	 * @return total number of iterations that were calculated
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	class EscapeTile : public Task
+	{
+	private:
+		/**
+		 * The image being rendered
+		 */
+		CImg<char>& m_image;
+
+		/**
+		 * The image configuration
+		 */
+		const Transform& m_trans;
+
+		/**
+		 * The colormap being used
+		 */
+		const ColorMapRGB* m_map;
+
+		/**
+		 * The region of the image to render
+		 */
+		Tile m_tile;
+
+		/**
+		 * True if the mandelbrot set is being rendered
+		 */
+		bool m_mbrot;
+
+		/**
+		 * The julia set complex constant
+		 */
+		complex<double> m_c;
+
+		/**
+		 * The kernel parameters
+		 */
+		KernelParams m_params;
+
+		/**
+		 * How the pixels of the tile are picked for iterating
+		 */
+		RenderMode m_mode;
+
+		/**
+		 * The symmetry of the image (null if it has none)
+		 */
+		Mirror* m_mirror;
+
+		/**
+		 * True if the tile lies in the region copied from partners
+		 */
+		bool m_reflected;
+
+		/**
+		 * The precision the tile is rendered in
+		 */
+		Precision m_precision;
+	public:
+		/**
+		 * Total number of iterations calculated in the tile
+		 */
+		unsigned long long total;
+
+		/**
+		 * The lane usage of the kernel in the tile
+		 */
+		KernelStats stats;
+
+		/**
+		 * Creates an EscapeTile with the given parameters
+		 *
+		 * @param image  the image being rendered
+		 * @param trans  the image configuration
+		 * @param map    the colormap being used
+		 * @param tile   the region of the image to render
+		 * @param mbrot  true if the mandelbrot set is being rendered
+		 * @param c      the julia set complex constant
+		 * @param params the kernel parameters
+		 * @param mode   how the pixels of the tile are picked for iterating
+		 * @param mirror the symmetry of the image (null if it has none)
+		 */
+		EscapeTile(CImg<char>& image, const Transform& trans, const ColorMapRGB* map, const Tile& tile,
+			bool mbrot, const complex<double>& c, const KernelParams& params, RenderMode mode, Mirror* mirror):
+		m_image(image), m_trans(trans), m_map(map),
+		m_tile(tile), m_mbrot(mbrot), m_c(c), m_params(params), m_mode(mode), m_mirror(mirror),
+		m_reflected(mirror && tile.x >= mirror->region.x && tile.y >= mirror->region.y
+			&& tile.x + tile.width <= mirror->region.x + mirror->region.width
+			&& tile.y + tile.height <= mirror->region.y + mirror->region.height),
+		m_precision(params.precision), total(0) {}
+
+		/**
+		 * Renders the tile with points in the selected precision (or the
+		 * cheapest one from AUTO_PRECISION up that resolves the pixels of the
+		 * tile if automatic).
+		 * Float tiles whose pixels are too close together for a float to
+		 * resolve are rendered in double instead, as are all float tiles when
+		 * the float kernels are not used (see floatKernels).
+		 */
+		void run()
+		{
+			Precision precision = m_params.precision;
+			Precision resolving = resolvingPrecision(m_trans, m_tile.x, m_tile.y, m_tile.width, m_tile.height);
+			if (m_params.automatic)
+				precision = min(precision, max(AUTO_PRECISION, resolving));
+			else if (precision == FLOAT_PRECISION && resolving != FLOAT_PRECISION)
+				precision = DOUBLE_PRECISION;
+			if (precision == FLOAT_PRECISION && !floatKernels())
+				precision = DOUBLE_PRECISION;
+			stats.tiles[precision]++;
+			m_precision = precision;
+
+			if (precision == FLOAT_PRECISION)
+				renderAs<float>();
+			else if (precision == DOUBLE_PRECISION)
+				renderAs<double>();
+			else if (precision == FIXED_PRECISION)
+				renderAs<fixed128>();
+			else
+				renderAs<ddouble>();
+		}
+
+		/**
+		 * Renders the tile with points stored as Real and iterations stored in
+		 * the narrowest type that holds the iteration limit
+		 */
+		template <typename Real>
+		void renderAs()
+		{
+			if (m_params.maxIter <= 0xFF)
+				render<unsigned char, Real>();
+			else if (m_params.maxIter <= 0xFFFF)
+				render<unsigned short, Real>();
+			else
+				render<unsigned, Real>();
+		}
+
+		/**
+		 * Maps the given pixel to the complex plane in double
+		 *
+		 * @param trans the image configuration
+		 * @param x     the x coord of the pixel
+		 * @param y     the y coord of the pixel
+		 * @param real  the real component mapped at the pixel (set)
+		 * @param imag  the imaginary component mapped at the pixel (set)
+		 */
+		static void mapPixel(const Transform& trans, unsigned x, unsigned y, double& real, double& imag)
+		{
+			complex<double> p = trans(x, y);
+			real = p.real();
+			imag = p.imag();
+		}
+
+		/**
+		 * Maps the given pixel to the complex plane in float
+		 *
+		 * @param trans the image configuration
+		 * @param x     the x coord of the pixel
+		 * @param y     the y coord of the pixel
+		 * @param real  the real component mapped at the pixel (set)
+		 * @param imag  the imaginary component mapped at the pixel (set)
+		 */
+		static void mapPixel(const Transform& trans, unsigned x, unsigned y, float& real, float& imag)
+		{
+			complex<double> p = trans(x, y);
+			real = p.real();
+			imag = p.imag();
+		}
+
+		/**
+		 * Maps the given pixel to the complex plane in double-double
+		 *
+		 * @param trans the image configuration
+		 * @param x     the x coord of the pixel
+		 * @param y     the y coord of the pixel
+		 * @param real  the real component mapped at the pixel (set)
+		 * @param imag  the imaginary component mapped at the pixel (set)
+		 */
+		static void mapPixel(const Transform& trans, unsigned x, unsigned y, ddouble& real, ddouble& imag)
+		{
+			trans.map(x, y, real, imag);
+		}
+
+		/**
+		 * Maps the given pixel to the complex plane in 128-bit fixed point
+		 *
+		 * @param trans the image configuration
+		 * @param x     the x coord of the pixel
+		 * @param y     the y coord of the pixel
+		 * @param real  the real component mapped at the pixel (set)
+		 * @param imag  the imaginary component mapped at the pixel (set)
+		 */
+		static void mapPixel(const Transform& trans, unsigned x, unsigned y, fixed128& real, fixed128& imag)
+		{
+			trans.map(x, y, real, imag);
+		}
+
+		/**
+		 * Returns the leading double of the given number
+		 *
+		 * @param x the number
+		 *
+		 * @return the leading double of the given number
+		 */
+		static double leading(double x) { return x; }
+
+		/**
+		 * Returns the leading double of the given number
+		 *
+		 * @param x the number
+		 *
+		 * @return the leading double of the given number
+		 */
+		static double leading(float x) { return x; }
+
+		/**
+		 * Returns the leading double of the given number
+		 *
+		 * @param x the number
+		 *
+		 * @return the leading double of the given number
+		 */
+		static double leading(const ddouble& x) { return x.hi; }
+
+		/**
+		 * Returns the leading double of the given number
+		 *
+		 * @param x the number
+		 *
+		 * @return the leading double of the given number
+		 */
+		static double leading(const fixed128& x) { return x.toDouble(); }
+
+		/**
+		 * Iterates the given pixels of the tile with the kernel storing
+		 * iterations as Count and points as Real
+		 *
+		 * @param pixels the pixels to iterate (indices into the tile)
+		 * @param result the iterations of each pixel of the tile (set at pixels)
+		 */
+		template <typename Count, typename Real>
+		void iterate(const vector<unsigned>& pixels, vector<Count>& result)
+		{
+			// Batch buffers (index maps each batch point back to its pixel)
+			vector<Real> zr, zi, cr, ci;
+			vector<unsigned> index;
+
+			// Map each pixel to its starting point and constant
+			Real pr, pi;
+			for (vector<unsigned>::const_iterator it = pixels.begin(); it != pixels.end(); ++it)
+			{
+				mapPixel(m_trans, m_tile.x + *it % m_tile.width, m_tile.y + *it / m_tile.width, pr, pi);
+
+				// Known Mandelbrot set interior never escapes, so skip iterating it
+				// (the table only holds the interior under z^2 + c)
+				if (m_mbrot && m_params.standard() && isInterior(leading(pr), leading(pi)))
+				{
+					result[*it] = m_params.maxIter;
+					continue;
+				}
+
+				index.push_back(*it);
+				zr.push_back(m_mbrot ? Real(m_params.criticalPoint()) : pr);
+				zi.push_back(m_mbrot ? Real(0) : pi);
+				cr.push_back(m_mbrot ? pr : Real(m_c.real()));
+				ci.push_back(m_mbrot ? pi : Real(m_c.imag()));
+			}
+
+			// Compute set map with the selected kernel
+			if (!index.empty())
+			{
+				vector<Count> batch(index.size());
+				runKernel(&zr[0], &zi[0], &cr[0], &ci[0], index.size(), m_params, &batch[0], stats);
+				for (unsigned j = 0; j < index.size(); j++)
+					result[index[j]] = batch[j];
+				stats.iterated += index.size();
+			}
+		}
+
+		/**
+		 * Adds the border pixels of the given rectangle of the tile to the
+		 * given list
+		 *
+		 * @param rect   the rectangle (in tile coords)
+		 * @param pixels the pixels (indices into the tile, added to)
+		 */
+		void border(const Tile& rect, vector<unsigned>& pixels) const
+		{
+			unsigned top = rect.y * m_tile.width + rect.x, bottom = top + (rect.height - 1) * m_tile.width;
+			for (unsigned i = 0; i < rect.width; i++)
+			{
+				pixels.push_back(top + i);
+				if (rect.height > 1) pixels.push_back(bottom + i);
+			}
+			for (unsigned j = 1; j + 1 < rect.height; j++)
+			{
+				pixels.push_back(top + j * m_tile.width);
+				if (rect.width > 1) pixels.push_back(top + j * m_tile.width + rect.width - 1);
+			}
+		}
+
+		/**
+		 * Computes the iterations of every pixel of the tile by subdivision
+		 * (Mariani-Silver). Only the border of each rectangle is iterated; a
+		 * rectangle whose border is all one iteration count is filled with it,
+		 * and any other is split in two across its longer side, the split line
+		 * being iterated as the new border shared by both halves. Rectangles
+		 * are taken a generation at a time, so that the borders of a whole
+		 * generation go to the kernel as one batch.
+		 *
+		 * @param result the iterations of each pixel of the tile (set)
+		 */
+		template <typename Count, typename Real>
+		void subdivide(vector<Count>& result)
+		{
+			// Pixels known (or being iterated), and the pixels to iterate next
+			vector<bool> known(m_tile.area(), false);
+			vector<unsigned> pending, edge;
+			vector<Tile> rects(1, Tile(0, 0, m_tile.width, m_tile.height)), next;
+
+			while (!rects.empty() || !pending.empty())
+			{
+				// Iterate the borders of this generation (and the rectangles left whole)
+				for (vector<Tile>::iterator it = rects.begin(); it != rects.end(); ++it)
+				{
+					edge.clear();
+					border(*it, edge);
+					for (vector<unsigned>::iterator p = edge.begin(); p != edge.end(); ++p)
+						if (!known[*p]) { known[*p] = true; pending.push_back(*p); }
+				}
+				iterate<Count, Real>(pending, result);
+				pending.clear();
+
+				// Fill, split or iterate whole each rectangle with an interior
+				next.clear();
+				for (vector<Tile>::iterator it = rects.begin(); it != rects.end(); ++it)
+				{
+					const Tile& r = *it;
+					if (r.width <= 2 || r.height <= 2) continue;
+
+					// Fill if the border is all one iteration count
+					edge.clear();
+					border(r, edge);
+					unsigned n = result[edge[0]];
+					bool uniform = true;
+					for (vector<unsigned>::iterator p = edge.begin(); uniform && p != edge.end(); ++p)
+						uniform = result[*p] == n;
+
+					if (uniform || r.width <= SUBDIVIDE_SIZE || r.height <= SUBDIVIDE_SIZE)
+					{
+						for (unsigned j = 1; j + 1 < r.height; j++)
+						{
+							for (unsigned i = 1; i + 1 < r.width; i++)
+							{
+								unsigned p = (r.y + j) * m_tile.width + r.x + i;
+								if (uniform)
+									result[p] = n;
+								else
+									pending.push_back(p);
+								known[p] = true;
+							}
+						}
+					}
+					else if (r.width >= r.height)
+					{
+						unsigned half = r.width / 2;
+						next.push_back(Tile(r.x, r.y, half + 1, r.height));
+						next.push_back(Tile(r.x + half, r.y, r.width - half, r.height));
+					}
+					else
+					{
+						unsigned half = r.height / 2;
+						next.push_back(Tile(r.x, r.y, r.width, half + 1));
+						next.push_back(Tile(r.x, r.y + half, r.width, r.height - half));
+					}
+				}
+				rects.swap(next);
+			}
+		}
+
+		/**
+		 * Adds the neighbours of the given pixel of the tile (above, below, left
+		 * and right) that are not yet known to the given list, marking them known
+		 *
+		 * @param p      the pixel (index into the tile)
+		 * @param known  the pixels known (or being iterated)
+		 * @param pixels the pixels (indices into the tile, added to)
+		 */
+		void neighbours(unsigned p, vector<bool>& known, vector<unsigned>& pixels) const
+		{
+			unsigned x = p % m_tile.width, y = p / m_tile.width;
+			if (y > 0                 && !known[p - m_tile.width]) { known[p - m_tile.width] = true; pixels.push_back(p - m_tile.width); }
+			if (y + 1 < m_tile.height && !known[p + m_tile.width]) { known[p + m_tile.width] = true; pixels.push_back(p + m_tile.width); }
+			if (x > 0                 && !known[p - 1])            { known[p - 1] = true;            pixels.push_back(p - 1); }
+			if (x + 1 < m_tile.width  && !known[p + 1])            { known[p + 1] = true;            pixels.push_back(p + 1); }
+		}
+
+		/**
+		 * Computes the iterations of every pixel of the tile by boundary
+		 * tracing. The edge of the tile is iterated first. Wherever an iterated
+		 * pixel differs from an iterated pixel up to TRACE_REACH away, the
+		 * neighbours above, below, left and right of both are iterated too, so
+		 * iterating creeps along each contour between bands of iteration counts
+		 * and stops everywhere else. Reaching past the eight neighbours keeps
+		 * contours from leaking through corners, and follows filaments thinner
+		 * than a pixel that only show up as a broken chain of pixels. Pixels
+		 * never reached are filled row by row from the left, then every
+		 * TRACE_CHECK-th of them across and down is iterated to check the fill,
+		 * and contours are followed again from any that was filled wrong.
+		 * Contours are followed a wave at a time, so that each wave goes to the
+		 * kernel as one batch.
+		 *
+		 * @param result the iterations of each pixel of the tile (set)
+		 */
+		template <typename Count, typename Real>
+		void trace(vector<Count>& result)
+		{
+			// Pixels known (or being iterated), pixels iterated, and the waves
+			vector<bool> known(m_tile.area(), false), done(m_tile.area(), false);
+			vector<unsigned> wave, next, filled;
+			border(Tile(0, 0, m_tile.width, m_tile.height), wave);
+			for (vector<unsigned>::iterator p = wave.begin(); p != wave.end(); ++p)
+				known[*p] = true;
+
+			while (!wave.empty())
+			{
+				// Iterate the wave
+				iterate<Count, Real>(wave, result);
+				for (vector<unsigned>::iterator p = wave.begin(); p != wave.end(); ++p)
+					done[*p] = true;
+
+				// Follow every contour the wave found into the next wave (and
+				// every pixel the check found filled wrong)
+				next.clear();
+				for (unsigned n = 0; n < wave.size(); n++)
+				{
+					unsigned p = wave[n], x = p % m_tile.width, y = p / m_tile.width;
+					if (!filled.empty() && result[p] != filled[n])
+						neighbours(p, known, next);
+					for (unsigned j = y > TRACE_REACH ? y - TRACE_REACH : 0; j <= y + TRACE_REACH && j < m_tile.height; j++)
+					{
+						for (unsigned i = x > TRACE_REACH ? x - TRACE_REACH : 0; i <= x + TRACE_REACH && i < m_tile.width; i++)
+						{
+							unsigned q = j * m_tile.width + i;
+							if (done[q] && result[q] != result[p])
+							{
+								neighbours(p, known, next);
+								neighbours(q, known, next);
+							}
+						}
+					}
+				}
+				filled.clear();
+
+				// Once no contour is left, fill the enclosed regions from the
+				// left (the left column is the edge) and check the fill
+				if (next.empty())
+				{
+					for (unsigned i = 0; i < m_tile.area(); i++)
+						if (!done[i]) result[i] = result[i - 1];
+					for (unsigned j = TRACE_CHECK / 2; j < m_tile.height; j += TRACE_CHECK)
+					{
+						for (unsigned i = TRACE_CHECK / 2; i < m_tile.width; i += TRACE_CHECK)
+						{
+							unsigned p = j * m_tile.width + i;
+							if (known[p]) continue;
+							known[p] = true;
+							next.push_back(p);
+							filled.push_back(result[p]);
+						}
+					}
+				}
+				wave.swap(next);
+			}
+		}
+
+		/**
+		 * Returns true if the given numbers are equal
+		 *
+		 * @param a the first number
+		 * @param b the second number
+		 *
+		 * @return true if the given numbers are equal
+		 */
+		static bool same(double a, double b) { return a == b; }
+
+		/**
+		 * Returns true if the given numbers are equal
+		 *
+		 * @param a the first number
+		 * @param b the second number
+		 *
+		 * @return true if the given numbers are equal
+		 */
+		static bool same(float a, float b) { return a == b; }
+
+		/**
+		 * Returns true if the given numbers are equal
+		 *
+		 * @param a the first number
+		 * @param b the second number
+		 *
+		 * @return true if the given numbers are equal
+		 */
+		static bool same(const ddouble& a, const ddouble& b) { return a.hi == b.hi && a.lo == b.lo; }
+
+		/**
+		 * Returns true if the given numbers are equal
+		 *
+		 * @param a the first number
+		 * @param b the second number
+		 *
+		 * @return true if the given numbers are equal
+		 */
+		static bool same(const fixed128& a, const fixed128& b) { return a.raw == b.raw; }
+
+		/**
+		 * Returns true if the given numbers are exact negatives of each other
+		 *
+		 * @param a the first number
+		 * @param b the second number
+		 *
+		 * @return true if the given numbers are exact negatives of each other
+		 */
+		static bool opposite(double a, double b) { return a == -b; }
+
+		/**
+		 * Returns true if the given numbers are exact negatives of each other
+		 *
+		 * @param a the first number
+		 * @param b the second number
+		 *
+		 * @return true if the given numbers are exact negatives of each other
+		 */
+		static bool opposite(float a, float b) { return a == -b; }
+
+		/**
+		 * Returns true if the given numbers are exact negatives of each other
+		 *
+		 * @param a the first number
+		 * @param b the second number
+		 *
+		 * @return true if the given numbers are exact negatives of each other
+		 */
+		static bool opposite(const ddouble& a, const ddouble& b) { return a.hi == -b.hi && a.lo == -b.lo; }
+
+		/**
+		 * Returns true if the given numbers are exact negatives of each other
+		 *
+		 * @param a the first number
+		 * @param b the second number
+		 *
+		 * @return true if the given numbers are exact negatives of each other
+		 */
+		static bool opposite(const fixed128& a, const fixed128& b) { return a.raw == -b.raw; }
+
+		/**
+		 * Computes the iterations of every pixel of the tile by copying them
+		 * from the partner of each pixel. A pixel is only copied if it maps to
+		 * exactly the conjugate (or negative) of its partner in Real, and its
+		 * partner was rendered in the same precision, so that the kernel would
+		 * have iterated it exactly as it iterated its partner. Every other
+		 * pixel is iterated.
+		 *
+		 * @param result the iterations of each pixel of the tile (set)
+		 */
+		template <typename Count, typename Real>
+		void reflect(vector<Count>& result)
+		{
+			vector<unsigned> pending;
+			Real pr, pi, qr, qi;
+			unsigned x, y, px, py;
+			for (unsigned i = 0; i < m_tile.area(); i++)
+			{
+				x = m_tile.x + i % m_tile.width;
+				y = m_tile.y + i / m_tile.width;
+				m_mirror->partner(x, y, px, py);
+				mapPixel(m_trans, x, y, pr, pi);
+				mapPixel(m_trans, px, py, qr, qi);
+
+				// Copy if the pixels line up exactly
+				unsigned p = py * m_mirror->width + px;
+				bool aligned = (m_mirror->conjugate ? same(pr, qr) : opposite(pr, qr)) && opposite(pi, qi);
+				if (aligned && m_mirror->precisions[p] == m_precision)
+				{
+					result[i] = m_mirror->counts[p];
+					stats.mirrored++;
+				}
+				else
+					pending.push_back(i);
+			}
+			iterate<Count, Real>(pending, result);
+		}
+
+		/**
+		 * Renders the tile with the kernel storing iterations as Count and
+		 * points as Real
+		 */
+		template <typename Count, typename Real>
+		void render()
+		{
+			// Compute the iterations of every pixel in the tile
+			unsigned count = m_tile.area();
+			vector<Count> result(count);
+			if (m_reflected)
+				reflect<Count, Real>(result);
+			else if (m_mode == SUBDIVIDE_MODE)
+				subdivide<Count, Real>(result);
+			else if (m_mode == TRACE_MODE)
+				trace<Count, Real>(result);
+			else
+			{
+				vector<unsigned> pixels(count);
+				for (unsigned i = 0; i < count; i++)
+					pixels[i] = i;
+				iterate<Count, Real>(pixels, result);
+			}
+
+			// Check a subdivided or traced tile against iterating every pixel
+			// (which is left out of the stats)
+			if (m_mode != BRUTE_FORCE_MODE && !m_reflected && getVerify())
+			{
+				KernelStats kept = stats;
+				vector<unsigned> pixels(count);
+				vector<Count> expected(count);
+				for (unsigned i = 0; i < count; i++)
+					pixels[i] = i;
+				iterate<Count, Real>(pixels, expected);
+				stats = kept;
+				for (unsigned i = 0; i < count; i++)
+					if (expected[i] != result[i]) stats.misfilled++;
+				stats.compared += count;
+			}
+
+			// Keep the iterations for the pixels mirroring the tile
+			if (m_mirror && !m_reflected)
+			{
+				for (unsigned i = 0; i < count; i++)
+				{
+					unsigned p = (m_tile.y + i / m_tile.width) * m_mirror->width + m_tile.x + i % m_tile.width;
+					m_mirror->counts[p]     = result[i];
+					m_mirror->precisions[p] = m_precision;
+				}
+			}
+
+			// Set colors and add to total
+			ColorRGB color;
+			unsigned x, y;
+			for (unsigned i = 0; i < count; i++)
+			{
+				x     = m_tile.x + i % m_tile.width;
+				y     = m_tile.y + i / m_tile.width;
+				color = m_map->color(result[i], m_params.maxIter);
+				m_image(x, y, 0) = color.red;
+				m_image(x, y, 1) = color.green;
+				m_image(x, y, 2) = color.blue;
+				total += result[i];
+			}
+		}
+	};
+
+	/**
+	 * Returns the rows after the axis k/2 whose partner k - y lies in an
+	 * image of the given size (the rows a flip about k/2 can copy)
+	 *
+	 * @param k     twice the coord of the axis
+	 * @param size  the size of the image along the flip
+	 * @param first the first row (set)
+	 * @param count the number of rows (set)
+	 */
+	static void flippedRange(long k, unsigned size, unsigned& first, unsigned& count)
+	{
+		long lo = k / 2 + 1, hi = min(k, (long)size - 1);
+		first = k < 1 ? 0 : lo;
+		count = k < 1 || lo > hi ? 0 : hi - lo + 1;
+	}
+
+	/**
+	 * Returns the rows whose partner k - y lies in an image of the given size
+	 *
+	 * @param k     twice the coord of the axis
+	 * @param size  the size of the image along the flip
+	 * @param first the first row (set)
+	 * @param count the number of rows (set)
+	 */
+	static void partnerRange(long k, unsigned size, unsigned& first, unsigned& count)
+	{
+		long lo = max(0L, k - ((long)size - 1)), hi = min(k, (long)size - 1);
+		first = lo > hi ? 0 : lo;
+		count = lo > hi ? 0 : hi - lo + 1;
+	}
+
+	/**
+	 * Rounds the given coord to the nearest whole pixel if it lies within
+	 * MIRROR_TOLERANCE of it
+	 *
+	 * @param v the coord
+	 * @param k the whole coord (set)
+	 *
+	 * @return true if the coord lies on a whole pixel
+	 */
+	static bool wholePixel(double v, long& k)
+	{
+		if (!(fabs(v) < 1e9)) return false;
+		k = (long)floor(v + 0.5);
+		return fabs(v - k) <= MIRROR_TOLERANCE;
+	}
+
+	/**
+	 * Finds the symmetry of the image, if it shows mirrored points. Under
+	 * the transform a pixel v maps to s R (v - shift) + o. A Mandelbrot set
+	 * is mirrored in the real axis, which the image shows mirrored in a row
+	 * (when R is 1 or -1) or a column (when R is i or -i) if the axis lies on
+	 * a whole or half pixel. A Julia set is mirrored through 0, which the
+	 * image shows mirrored through a pixel at any rotation if 0 maps to a
+	 * whole or half pixel. Each pixel is still checked before it is copied.
+	 *
+	 * @param trans  the image configuration
+	 * @param params the kernel parameters
+	 * @param mbrot  true if the mandelbrot set is being rendered
+	 * @param width  the width of the image
+	 * @param height the height of the image
+	 * @param mirror the symmetry of the image (set)
+	 *
+	 * @return true if the image has pixels to mirror
 	 */
-	unsigned generateJuliaSetImage(cimg_library::CImg<char>& image, const complex<double>& c, Transform& trans, const ColorMapRGB* map)
+	static bool findMirror(const Transform& trans, const KernelParams& params, bool mbrot,
+		unsigned width, unsigned height, Mirror& mirror)
 	{
-		// Initialize buffers
-		complex<double> z;     // Z Complex buffer
-		ColorRGB color;	       // Color value buffer
-		int result, total = 0; // Tterations buffer
+		if (!symmetry || !(mbrot ? params.conjugateSymmetric() : params.pointSymmetric()))
+			return false;
 
-		// For each pixel location in image
-		cimg_forXY(image, x, y) 
+		// The pixel that would map to the mirror image of pixel 0 (k - v is
+		// the partner of v, flipped in y, x or both)
+		const complex<double> r = conj(trans.rotation);
+		const double s = trans.spacing();
+		mirror.conjugate = mbrot;
+		mirror.width     = width;
+		unsigned x, w, y, h;
+		if (mbrot)
+		{
+			// Conjugating flips y when R^2 is 1 and x when it is -1
+			complex<double> k = 2.0 * trans.shift - complex<double>(0, 2 * trans.offset.imag()) * r / s;
+			complex<double> q = r * r;
+			mirror.flipY = abs(q - 1.0) <= MIRROR_TOLERANCE / max(width, height);
+			mirror.flipX = abs(q + 1.0) <= MIRROR_TOLERANCE / max(width, height);
+			if (mirror.flipY)
+			{
+				if (fabs(k.real() - 2 * trans.shift.real()) > MIRROR_TOLERANCE || !wholePixel(k.imag(), mirror.ky))
+					return false;
+				x = 0; w = width;
+				flippedRange(mirror.ky, height, y, h);
+			}
+			else if (mirror.flipX)
+			{
+				if (fabs(k.imag() - 2 * trans.shift.imag()) > MIRROR_TOLERANCE || !wholePixel(k.real(), mirror.kx))
+					return false;
+				y = 0; h = height;
+				flippedRange(mirror.kx, width, x, w);
+			}
+			else
+				return false;
+		}
+		else
 		{
-			// Compute JuliaSet map at pixel location
-			z      = trans(x,y); 			  // Complex number z at pixel
-			result = juliaSetAlgorithm(z, c); // Julia set algorithm
-			color  = map->color(result);      // Compute color map
-			
-			// Set Color
-			image(x, y, 0) = color.red;
-			image(x, y, 1) = color.green;
-			image(x, y, 2) = color.blue;
+			// Negating flips both, so copy whole rows or whole columns, whichever copies more
+			complex<double> k = 2.0 * trans.shift - 2.0 * trans.offset * r / s;
+			if (!wholePixel(k.real(), mirror.kx) || !wholePixel(k.imag(), mirror.ky))
+				return false;
+			mirror.flipX = mirror.flipY = true;
+			unsigned rx, rw, ry, rh, cx, cw, cy, ch;
+			flippedRange(mirror.ky, height, ry, rh);
+			partnerRange(mirror.kx, width,  rx, rw);
+			flippedRange(mirror.kx, width,  cx, cw);
+			partnerRange(mirror.ky, height, cy, ch);
+			if (rw * rh >= cw * ch)
+			{
+				x = rx; w = rw;
+				y = ry; h = rh;
+			}
+			else
+			{
+				x = cx; w = cw;
+				y = cy; h = ch;
+			}
+		}
+
+		mirror.region = Tile(x, y, w, h);
+		if (mirror.region.area() == 0)
+			return false;
+
+		// Give up if the pixels mostly miss their partners by a rounding (an
+		// offset that is not a whole number of pixels in binary)
+		unsigned aligned = 0, px, py;
+		for (unsigned i = 0; i < MIRROR_SAMPLES; i++)
+		{
+			unsigned sx = x + i * w / MIRROR_SAMPLES, sy = y + i * h / MIRROR_SAMPLES;
+			mirror.partner(sx, sy, px, py);
+			complex<double> a = trans(sx, sy), b = trans(px, py);
+			if ((mbrot ? a.real() == b.real() : a.real() == -b.real()) && a.imag() == -b.imag())
+				aligned++;
+		}
+		return 2 * aligned >= MIRROR_SAMPLES;
+	}
+
+	/**
+	 * Renders the given tiles of the Julia or Mandelbrot set image on the shared ThreadPool
+	 *
+	 * @param tiles  the tiles to render
+	 * @param image  the image object to render
+	 * @param trans  the image configuration
+	 * @param map    the colormap being used
+	 * @param mbrot  true if the mandelbrot set is being rendered
+	 * @param c      the julia set complex constant
+	 * @param params the kernel parameters
+	 * @param mirror the symmetry of the image (null if it has none)
+	 * @param stats  the lane usage of the kernel (added to if given)
+	 *
+	 * @return total number of iterations that were calculated
+	 */
+	static unsigned long long runTiles(const vector<Tile>& tiles, CImg<char>& image, const Transform& trans, const ColorMapRGB* map,
+		bool mbrot, const complex<double>& c, const KernelParams& params, Mirror* mirror, KernelStats* stats)
+	{
+		// Create a task for each tile
+		vector<Task*> tasks;
+		for (vector<Tile>::const_iterator it = tiles.begin(); it != tiles.end(); ++it)
+			tasks.push_back(new EscapeTile(image, trans, map, *it, mbrot, c, params, mode, mirror));
 
-			// Add to total
-			total += result;
+		// Run tasks
+		getThreadPool().run(tasks);
+
+		// Sum totals and clean up
+		unsigned long long total = 0;
+		for (vector<Task*>::iterator it = tasks.begin(); it != tasks.end(); ++it)
+		{
+			total += ((EscapeTile*)*it)->total;
+			if (stats) *stats += ((EscapeTile*)*it)->stats;
+			delete *it;
 		}
 
 		// Return total
@@ -121,39 +1036,142 @@ namespace fractal
 	}
 
 	/**
-	 * Generates a Mandelbrot set image in the given object with the given complex constant
+	 * Renders the Julia or Mandelbrot set image tile by tile on the shared ThreadPool.
+	 * If the image is symmetric, the tiles outside the mirrored region are
+	 * rendered first, and the mirrored region is then copied from them.
 	 *
-	 * @param image the image object to generate the Mandelbrot set in
-	 * @param trans the image configuration
-	 * @param map   the colormap being used
+	 * @param image  the image object to render
+	 * @param trans  the image configuration
+	 * @param map    the colormap being used
+	 * @param mbrot  true if the mandelbrot set is being rendered
+	 * @param c      the julia set complex constant
+	 * @param params the kernel parameters
+	 * @param stats  the lane usage of the kernel (added to if given)
 	 *
 	 * @return total number of iterations that were calculated
 	 */
-	unsigned generateMandelbrotSetImage(cimg_library::CImg<char>& image, Transform& trans, const ColorMapRGB* map)
+	static unsigned long long renderTiles(CImg<char>& image, const Transform& trans, const ColorMapRGB* map,
+		bool mbrot, const complex<double>& c, const KernelParams& params, KernelStats* stats)
 	{
-		// Initialize buffers
-		complex<double> c;     // C Complex buffer
-		ColorRGB color;	       // Color value buffer
-		int result, total = 0; // Tterations buffer
+		Mirror mirror;
+		unsigned width = image.width(), height = image.height();
+		if (!findMirror(trans, params, mbrot, width, height, mirror))
+			return runTiles(splitTiles(width, height), image, trans, map, mbrot, c, params, 0, stats);
 
-		// For each pixel location in image
-		cimg_forXY(image, x, y) 
+		// Render everything around the mirrored region
+		const Tile& r = mirror.region;
+		mirror.counts.resize(width * height);
+		mirror.precisions.resize(width * height);
+		vector<Tile> tiles, part;
+		Tile around[4] = {
+			Tile(0, 0, width, r.y),
+			Tile(0, r.y, r.x, r.height),
+			Tile(r.x + r.width, r.y, width - r.x - r.width, r.height),
+			Tile(0, r.y + r.height, width, height - r.y - r.height)
+		};
+		for (unsigned i = 0; i < 4; i++)
 		{
-			// Compute JuliaSet map at pixel location
-			c      = trans(x, y);			    // Complex number c at pixel
-			result = mandelbrotSetAlgorithm(c); // Mandelbrot set algorithm
-			color  = map->color(result);		// Compute color map
-			
-			// Set Color
-			image(x, y, 0) = color.red;
-			image(x, y, 1) = color.green;
-			image(x, y, 2) = color.blue;
+			part = splitTiles(around[i]);
+			tiles.insert(tiles.end(), part.begin(), part.end());
+		}
+		unsigned long long total = runTiles(tiles, image, trans, map, mbrot, c, params, &mirror, stats);
+
+		// Then copy the mirrored region
+		return total + runTiles(splitTiles(r), image, trans, map, mbrot, c, params, &mirror, stats);
+	}
 
-			// Add to total
-			total += result;
+	/**
+	 * Sets whether pixels mirroring other pixels of the image (under the
+	 * symmetry of the set) are copied instead of being iterated
+	 *
+	 * @param enabled true to copy mirrored pixels
+	 */
+	void setSymmetry(bool enabled)
+	{
+		symmetry = enabled;
+	}
+
+	/**
+	 * Selects how the pixels of each tile are picked for iterating
+	 * ("brute-force", "subdivide" or "trace")
+	 *
+	 * @param name the name of the render mode
+	 *
+	 * @throw Error when name is not a render mode
+	 */
+	void selectRenderMode(string name) throw(Error)
+	{
+		// Find render mode
+		for (unsigned i = 0; i < RENDER_MODE_COUNT; i++)
+		{
+			if (name == modeNames[i])
+			{
+				mode = (RenderMode)i;
+				return;
+			}
 		}
 
-		// Return total
-		return total;
+		// Error if not found
+		throw Error("Undefined render mode name: " + name + ". See -help for available render modes.");
+	}
+
+	/**
+	 * Returns the selected render mode
+	 *
+	 * @return the selected render mode
+	 */
+	RenderMode getRenderMode()
+	{
+		return mode;
+	}
+
+	/**
+	 * Returns the name of the given render mode
+	 *
+	 * @param mode the render mode
+	 *
+	 * @return the name of the given render mode
+	 */
+	string getRenderModeName(RenderMode mode)
+	{
+		return modeNames[mode];
+	}
+
+	/**
+	 * Generates a Juliaset Image in the given object with the given complex constant
+	 *
+	 * @param image the image object to generate the Juliaset in
+	 * @param c     the complex constant being used
+	 * @param trans the image configuration
+	 * @param map   the colormap being used
+	 * @param stats the lane usage of the kernel (added to if given)
+	 *
+	 * @return total number of iterations that were calculated
+	 */
+	unsigned long long generateJuliaSetImage(cimg_library::CImg<char>& image, const complex<double>& c, Transform& trans, const ColorMapRGB* map, KernelStats* stats)
+	{
+		// Look for the attracting cycle of c once for the whole image
+		KernelParams params = kernelParams(trans, c);
+		if (params.precision == PERTURBATION_PRECISION)
+			return generatePerturbedImage(image, trans, map, false, c, params, stats);
+		return renderTiles(image, trans, map, false, c, params, stats);
+	}
+
+	/**
+	 * Generates a Mandelbrot set image in the given object with the given complex constant
+	 *
+	 * @param image the image object to generate the Mandelbrot set in
+	 * @param trans the image configuration
+	 * @param map   the colormap being used
+	 * @param stats the lane usage of the kernel (added to if given)
+	 *
+	 * @return total number of iterations that were calculated
+	 */
+	unsigned long long generateMandelbrotSetImage(cimg_library::CImg<char>& image, Transform& trans, const ColorMapRGB* map, KernelStats* stats)
+	{
+		KernelParams params = kernelParams(trans);
+		if (params.precision == PERTURBATION_PRECISION)
+			return generatePerturbedImage(image, trans, map, true, complex<double>(0,0), params, stats);
+		return renderTiles(image, trans, map, true, complex<double>(0,0), params, stats);
 	}
 }
\ No newline at end of file
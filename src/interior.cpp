@@ -0,0 +1,87 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/interior.h"
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	// Disks around the nuclei of the larger hyperbolic components, shrunk
+	// until the attracting cycle multiplier stays below 0.98 on the rim
+	static const InteriorDisk table[] = {
+		{ -0.122561166876654,  0.744861766619744, 0.0858 }, // period 3 (1/3 bulb)
+		{ -0.122561166876654, -0.744861766619744, 0.0858 }, // period 3 (2/3 bulb)
+		{ -1.310702641336833,  0.0,               0.0534 }, // period 4 (on period 2)
+		{  0.282271390766914,  0.530060617578525, 0.0395 }, // period 4 (1/4 bulb)
+		{  0.282271390766914, -0.530060617578525, 0.0395 }, // period 4 (3/4 bulb)
+		{ -0.504340175446244,  0.562765761452982, 0.0357 }, // period 5 (2/5 bulb)
+		{ -0.504340175446244, -0.562765761452982, 0.0357 }, // period 5 (3/5 bulb)
+		{  0.379513588015924,  0.334932305597498, 0.0211 }, // period 5 (1/5 bulb)
+		{  0.379513588015924, -0.334932305597498, 0.0211 }, // period 5 (4/5 bulb)
+		{ -1.381547484432062,  0.0,               0.0116 }, // period 8 (on period 4)
+		{ -1.754877666246693,  0.0,               0.0046 }  // period 3 (real minibrot)
+	};
+
+	// Number of disks in the table
+	static const unsigned TABLE_SIZE = sizeof(table) / sizeof(InteriorDisk);
+
+	// True if the table is checked
+	static bool useTable = false;
+
+	/**
+	 * Returns true if c lies inside one of the disks of the interior table
+	 *
+	 * @param cr the real component of c
+	 * @param ci the imaginary component of c
+	 *
+	 * @return true if c lies inside one of the disks of the interior table
+	 */
+	bool inInteriorTable(double cr, double ci)
+	{
+		for (unsigned i = 0; i < TABLE_SIZE; i++)
+		{
+			double x = cr - table[i].real, y = ci - table[i].imag;
+			if (x*x + y*y < table[i].radius*table[i].radius) return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Sets whether the interior table is checked by isInterior
+	 *
+	 * @param use true if the interior table is to be checked
+	 */
+	void setInteriorTable(bool use)
+	{
+		useTable = use;
+	}
+
+	/**
+	 * Returns true if c is known to be in the Mandelbrot set without
+	 * iterating it (it lies in the main cardioid, the period-2 disk or,
+	 * if enabled, one of the disks of the interior table)
+	 *
+	 * @param cr the real component of c
+	 * @param ci the imaginary component of c
+	 *
+	 * @return true if c is known to be in the Mandelbrot set
+	 */
+	bool isInterior(double cr, double ci)
+	{
+		return inMainCardioid(cr, ci)
+			|| inPeriod2Disk(cr, ci)
+			|| (useTable && inInteriorTable(cr, ci));
+	}
+}
@@ -0,0 +1,1135 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/kernel.h"
+#include "Fractal/cpu.h"
+#include "Fractal/fractal.h"
+
+// Libraries being used
+#include <complex>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include <sstream>
+
+// Namespaces being used
+using namespace std;
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * A kernel and its name
+	 */
+	struct KernelEntry
+	{
+		/**
+		 * The name of the kernel
+		 */
+		const char* name;
+
+		/**
+		 * The kernel function storing iterations as unsigned char
+		 */
+		EscapeKernel<unsigned char>::Function kernel8;
+
+		/**
+		 * The kernel function storing iterations as unsigned short
+		 */
+		EscapeKernel<unsigned short>::Function kernel16;
+
+		/**
+		 * The kernel function storing iterations as unsigned
+		 */
+		EscapeKernel<unsigned>::Function kernel32;
+
+		/**
+		 * The float kernel function of the same instruction set storing iterations as unsigned char
+		 */
+		EscapeKernel<unsigned char>::FloatFunction floatKernel8;
+
+		/**
+		 * The float kernel function of the same instruction set storing iterations as unsigned short
+		 */
+		EscapeKernel<unsigned short>::FloatFunction floatKernel16;
+
+		/**
+		 * The float kernel function of the same instruction set storing iterations as unsigned
+		 */
+		EscapeKernel<unsigned>::FloatFunction floatKernel32;
+
+		/**
+		 * The formula kernel function of the same instruction set storing iterations as unsigned char
+		 */
+		EscapeKernel<unsigned char>::Function formulaKernel8;
+
+		/**
+		 * The formula kernel function of the same instruction set storing iterations as unsigned short
+		 */
+		EscapeKernel<unsigned short>::Function formulaKernel16;
+
+		/**
+		 * The formula kernel function of the same instruction set storing iterations as unsigned
+		 */
+		EscapeKernel<unsigned>::Function formulaKernel32;
+
+		/**
+		 * Returns true if the cpu supports the kernel
+		 */
+		bool (*supported)();
+	};
+
+	/**
+	 * Returns true on every cpu
+	 *
+	 * @return true
+	 */
+	static bool anyCpu()
+	{
+		return true;
+	}
+
+	/**
+	 * Returns true if the cpu supports SSE2
+	 *
+	 * @return true if the cpu supports SSE2
+	 */
+	static bool sse2Cpu()
+	{
+		return getCpuFeatures().sse2;
+	}
+
+	/**
+	 * Returns true if the cpu supports AVX2 and FMA
+	 *
+	 * @return true if the cpu supports AVX2 and FMA
+	 */
+	static bool avx2Cpu()
+	{
+		return getCpuFeatures().avx2 && getCpuFeatures().fma;
+	}
+
+	/**
+	 * Returns true if the cpu supports AVX-512
+	 *
+	 * @return true if the cpu supports AVX-512
+	 */
+	static bool avx512Cpu()
+	{
+		return getCpuFeatures().avx512f;
+	}
+
+	/**
+	 * Returns true if the cpu supports AVX-512 and BMI2
+	 *
+	 * @return true if the cpu supports AVX-512 and BMI2
+	 */
+	static bool avx512RefillCpu()
+	{
+		return avx512Cpu() && getCpuFeatures().bmi2;
+	}
+
+	// Entry for the kernel templates with the given name, instantiated for every count width
+	#define KERNEL_ENTRY(name, kernel, floatKernel, formulaKernel, cpu) \
+		{ name, kernel<unsigned char>, kernel<unsigned short>, kernel<unsigned>, \
+		  floatKernel<unsigned char>, floatKernel<unsigned short>, floatKernel<unsigned>, \
+		  formulaKernel<unsigned char>, formulaKernel<unsigned short>, formulaKernel<unsigned>, cpu }
+
+	// Available kernels (fastest first, which is the order auto tries them in;
+	// every cpu with AVX-512 also has AVX2 for the formula kernel)
+	static const KernelEntry kernels[] = {
+		KERNEL_ENTRY("avx512-refill", avx512RefillKernel, avx512FloatRefillKernel, avx2FormulaKernel, avx512RefillCpu),
+		KERNEL_ENTRY("avx2",          avx2Kernel,         avx2FloatKernel,         avx2FormulaKernel, avx2Cpu),
+		KERNEL_ENTRY("avx2-refill",   avx2RefillKernel,   avx2FloatKernel,         avx2FormulaKernel, avx2Cpu),
+		KERNEL_ENTRY("avx512",        avx512Kernel,       avx512FloatKernel,       avx2FormulaKernel, avx512Cpu),
+		KERNEL_ENTRY("sse2",          sse2Kernel,         floatKernel,             formulaKernel,     sse2Cpu),
+		KERNEL_ENTRY("scalar",        scalarKernel,       floatKernel,             formulaKernel,     anyCpu),
+		KERNEL_ENTRY("reference",     referenceKernel,    floatKernel,             formulaKernel,     anyCpu)
+	};
+
+	/**
+	 * Returns the function of the given kernel storing iterations as Count
+	 *
+	 * @param entry the kernel
+	 *
+	 * @return the function of the kernel
+	 */
+	template <typename Count>
+	static typename EscapeKernel<Count>::Function kernelFunction(const KernelEntry& entry);
+
+	/**
+	 * Returns the function of the given kernel storing iterations as unsigned char
+	 *
+	 * @param entry the kernel
+	 *
+	 * @return the function of the kernel
+	 */
+	template <>
+	EscapeKernel<unsigned char>::Function kernelFunction<unsigned char>(const KernelEntry& entry)
+	{
+		return entry.kernel8;
+	}
+
+	/**
+	 * Returns the function of the given kernel storing iterations as unsigned short
+	 *
+	 * @param entry the kernel
+	 *
+	 * @return the function of the kernel
+	 */
+	template <>
+	EscapeKernel<unsigned short>::Function kernelFunction<unsigned short>(const KernelEntry& entry)
+	{
+		return entry.kernel16;
+	}
+
+	/**
+	 * Returns the function of the given kernel storing iterations as unsigned
+	 *
+	 * @param entry the kernel
+	 *
+	 * @return the function of the kernel
+	 */
+	template <>
+	EscapeKernel<unsigned>::Function kernelFunction<unsigned>(const KernelEntry& entry)
+	{
+		return entry.kernel32;
+	}
+
+	/**
+	 * Returns the float function of the given kernel storing iterations as Count
+	 *
+	 * @param entry the kernel
+	 *
+	 * @return the float function of the kernel
+	 */
+	template <typename Count>
+	static typename EscapeKernel<Count>::FloatFunction floatKernelFunction(const KernelEntry& entry);
+
+	/**
+	 * Returns the float function of the given kernel storing iterations as unsigned char
+	 *
+	 * @param entry the kernel
+	 *
+	 * @return the float function of the kernel
+	 */
+	template <>
+	EscapeKernel<unsigned char>::FloatFunction floatKernelFunction<unsigned char>(const KernelEntry& entry)
+	{
+		return entry.floatKernel8;
+	}
+
+	/**
+	 * Returns the float function of the given kernel storing iterations as unsigned short
+	 *
+	 * @param entry the kernel
+	 *
+	 * @return the float function of the kernel
+	 */
+	template <>
+	EscapeKernel<unsigned short>::FloatFunction floatKernelFunction<unsigned short>(const KernelEntry& entry)
+	{
+		return entry.floatKernel16;
+	}
+
+	/**
+	 * Returns the float function of the given kernel storing iterations as unsigned
+	 *
+	 * @param entry the kernel
+	 *
+	 * @return the float function of the kernel
+	 */
+	template <>
+	EscapeKernel<unsigned>::FloatFunction floatKernelFunction<unsigned>(const KernelEntry& entry)
+	{
+		return entry.floatKernel32;
+	}
+
+	/**
+	 * Returns the formula function of the given kernel storing iterations as Count
+	 *
+	 * @param entry the kernel
+	 *
+	 * @return the formula function of the kernel
+	 */
+	template <typename Count>
+	static typename EscapeKernel<Count>::Function formulaKernelFunction(const KernelEntry& entry);
+
+	/**
+	 * Returns the formula function of the given kernel storing iterations as unsigned char
+	 *
+	 * @param entry the kernel
+	 *
+	 * @return the formula function of the kernel
+	 */
+	template <>
+	EscapeKernel<unsigned char>::Function formulaKernelFunction<unsigned char>(const KernelEntry& entry)
+	{
+		return entry.formulaKernel8;
+	}
+
+	/**
+	 * Returns the formula function of the given kernel storing iterations as unsigned short
+	 *
+	 * @param entry the kernel
+	 *
+	 * @return the formula function of the kernel
+	 */
+	template <>
+	EscapeKernel<unsigned short>::Function formulaKernelFunction<unsigned short>(const KernelEntry& entry)
+	{
+		return entry.formulaKernel16;
+	}
+
+	/**
+	 * Returns the formula function of the given kernel storing iterations as unsigned
+	 *
+	 * @param entry the kernel
+	 *
+	 * @return the formula function of the kernel
+	 */
+	template <>
+	EscapeKernel<unsigned>::Function formulaKernelFunction<unsigned>(const KernelEntry& entry)
+	{
+		return entry.formulaKernel32;
+	}
+
+	// Number of available kernels
+	static const unsigned KERNEL_COUNT = sizeof(kernels) / sizeof(KernelEntry);
+
+	// Selected kernel
+	static const KernelEntry* selected = &kernels[KERNEL_COUNT - 2];
+
+	// True if batches are verified against the reference kernel
+	static bool verifying = false;
+
+	// True if orbits are checked for cycles
+	static bool periodicity = true;
+
+	// True if julia set orbits are captured by the attracting cycle of c
+	static bool capturing = true;
+
+	// Iteration limit (0 picks it from the zoom)
+	static unsigned iterationLimit = MAX_ITER;
+
+	// Exponent d of the iteration function z = z^d + c
+	static double exponent = DEFAULT_EXPONENT;
+
+	// Iteration function
+	static Formula formula = STANDARD_FORMULA;
+
+	// Constant p of the Phoenix formula
+	static complex<double> phoenix = DEFAULT_PHOENIX;
+
+	// Compiled iteration function (used if its formula is not empty)
+	static Program program;
+
+	// True if programs are built into native code
+	static bool building = false;
+
+	// Directory native builds are cached in
+	static string nativeCache;
+
+	// Native build of the program (used if loaded)
+	static NativeProgram native;
+
+	// Names of the formulas (in the order of Formula)
+	static const char* formulaNames[] = { "standard", "burning-ship", "tricorn", "phoenix", "exp", "sin", "cos" };
+
+	// Selected precision
+	static Precision precision = DOUBLE_PRECISION;
+
+	// True if precisions are picked for each image and tile
+	static bool automatic = true;
+
+	// Names of the precisions (in the order of Precision)
+	static const char* precisionNames[] = { "float", "double", "double-double", "fixed", "perturbation" };
+
+	// Precisions auto picks from, cheapest first, before falling back to
+	// perturbation (which is faster than double-double at every zoom that
+	// needs either, so double-double is only used when selected)
+	static const Precision autoPrecisions[] = { FLOAT_PRECISION, DOUBLE_PRECISION };
+
+	// Relative rounding error of each precision auto picks from
+	static const double autoEpsilons[] = { FLT_EPSILON, DBL_EPSILON };
+
+	// Number of precisions auto picks from
+	static const unsigned AUTO_COUNT = sizeof(autoPrecisions) / sizeof(Precision);
+
+	/**
+	 * Creates KernelParams with the default iteration limit and periodicity
+	 * detection off
+	 */
+	KernelParams::KernelParams():
+	maxIter(MAX_ITER), precision(DOUBLE_PRECISION), automatic(false),
+	tolerance(0), capture(false), captureReal(0), captureImag(0), exponent(DEFAULT_EXPONENT),
+	formula(STANDARD_FORMULA), phoenixReal(DEFAULT_PHOENIX.real()), phoenixImag(DEFAULT_PHOENIX.imag()), program(0), native(0) {}
+
+	/**
+	 * Creates KernelParams with the given iteration limit and periodicity tolerance
+	 *
+	 * @param maxIter   the iteration limit
+	 * @param tolerance the periodicity tolerance
+	 */
+	KernelParams::KernelParams(unsigned maxIter, double tolerance):
+	maxIter(maxIter), precision(DOUBLE_PRECISION), automatic(false),
+	tolerance(tolerance), capture(false), captureReal(0), captureImag(0), exponent(DEFAULT_EXPONENT),
+	formula(STANDARD_FORMULA), phoenixReal(DEFAULT_PHOENIX.real()), phoenixImag(DEFAULT_PHOENIX.imag()), program(0), native(0) {}
+
+	/**
+	 * Creates KernelParams with the given iteration limit that capture orbits
+	 * coming within the given radius of a point of an attracting cycle
+	 *
+	 * @param maxIter   the iteration limit
+	 * @param attractor the attracting cycle
+	 */
+	KernelParams::KernelParams(unsigned maxIter, const Attractor& attractor):
+	maxIter(maxIter), precision(DOUBLE_PRECISION), automatic(false), tolerance(attractor.radius), capture(true),
+	captureReal(attractor.point.real()), captureImag(attractor.point.imag()), exponent(DEFAULT_EXPONENT),
+	formula(STANDARD_FORMULA), phoenixReal(DEFAULT_PHOENIX.real()), phoenixImag(DEFAULT_PHOENIX.imag()), program(0), native(0) {}
+
+	/**
+	 * Returns true if points are iterated with z = z^2 + c, which is the
+	 * only iteration function with vector, deep zoom and perturbation
+	 * kernels, an interior table and attracting cycles
+	 *
+	 * @return true if points are iterated with z = z^2 + c
+	 */
+	bool KernelParams::standard() const
+	{
+		return exponent == 2 && formula == STANDARD_FORMULA && !program;
+	}
+
+	/**
+	 * Returns true if points are iterated with a transcendental formula
+	 * (c e^z, c sin z or c cos z), which ignore the exponent
+	 *
+	 * @return true if points are iterated with a transcendental formula
+	 */
+	bool KernelParams::transcendental() const
+	{
+		return formula >= EXP_FORMULA && !program;
+	}
+
+	/**
+	 * Returns the critical point of the iteration function, which Mandelbrot
+	 * sets start every orbit from (pi/2 for c sin z, 0 otherwise)
+	 *
+	 * @return the critical point of the iteration function
+	 */
+	double KernelParams::criticalPoint() const
+	{
+		return formula == SINE_FORMULA && !program ? M_PI / 2 : 0;
+	}
+
+	/**
+	 * Returns true if the orbit of conj(c) from a real starting point is
+	 * the conjugate of the orbit of c, so the Mandelbrot set is mirrored
+	 * in the real axis (every formula but the Burning Ship, and Phoenix
+	 * only with a real p)
+	 *
+	 * @return true if the Mandelbrot set is mirrored in the real axis
+	 */
+	bool KernelParams::conjugateSymmetric() const
+	{
+		if (program) return false;
+		return formula != BURNING_SHIP_FORMULA && (formula != PHOENIX_FORMULA || phoenixImag == 0);
+	}
+
+	/**
+	 * Returns true if -z escapes after exactly as many iterations as z, so
+	 * the Julia set is mirrored through 0 (even whole exponents of z^d + c
+	 * and the Tricorn, any Burning Ship, c sin z and c cos z)
+	 *
+	 * @return true if the Julia set is mirrored through 0
+	 */
+	bool KernelParams::pointSymmetric() const
+	{
+		if (program) return false;
+		switch (formula)
+		{
+			case STANDARD_FORMULA:
+			case TRICORN_FORMULA:
+				return fmod(exponent, 2) == 0;
+			case BURNING_SHIP_FORMULA:
+			case SINE_FORMULA:
+			case COSINE_FORMULA:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	/**
+	 * Creates empty KernelStats
+	 */
+	KernelStats::KernelStats():
+	used(0), issued(0), checked(0), mismatched(0), maxDifference(0), references(0), reused(0), glitched(0), skipped(0), iterated(0), mirrored(0), compared(0), misfilled(0)
+	{
+		fill(tiles, tiles + PRECISION_COUNT, 0);
+	}
+
+	/**
+	 * Adds the given stats to these stats
+	 *
+	 * @param other the stats to add
+	 *
+	 * @return these stats
+	 */
+	KernelStats& KernelStats::operator+=(const KernelStats& other)
+	{
+		used       += other.used;
+		issued     += other.issued;
+		checked    += other.checked;
+		mismatched += other.mismatched;
+		references += other.references;
+		reused     += other.reused;
+		glitched   += other.glitched;
+		skipped    += other.skipped;
+		iterated   += other.iterated;
+		mirrored   += other.mirrored;
+		compared   += other.compared;
+		misfilled  += other.misfilled;
+		for (unsigned i = 0; i < PRECISION_COUNT; i++)
+			tiles[i] += other.tiles[i];
+		if (other.maxDifference > maxDifference)
+			maxDifference = other.maxDifference;
+		return *this;
+	}
+
+	/**
+	 * Returns the fraction of issued lane-iterations that were used
+	 *
+	 * @return the fraction of issued lane-iterations that were used
+	 */
+	double KernelStats::utilisation() const
+	{
+		return issued ? used / (double)issued : 1.0;
+	}
+
+	/**
+	 * Computes the batch one point at a time with juliaSetAlgorithm (the
+	 * reference that every other kernel is verified against, which always
+	 * runs every iteration)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void referenceKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		complex<double> z;
+		unsigned long long used = 0;
+		for (unsigned i = 0; i < count; i++)
+		{
+			z      = complex<double>(zr[i], zi[i]);
+			out[i] = juliaSetAlgorithm(z, complex<double>(cr[i], ci[i]), params.maxIter);
+
+			// Escaping points also spend the iteration they escaped on
+			used += out[i] < params.maxIter ? out[i] + 1 : out[i];
+		}
+
+		// One lane is always busy
+		stats.used   += used;
+		stats.issued += used;
+	}
+
+	/**
+	 * Computes the batch one point at a time with the iteration function
+	 * expanded by hand and a squared-magnitude bailout
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void scalarKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		const double tolerance = params.tolerance * params.tolerance;
+		unsigned long long used = 0;
+		for (unsigned i = 0; i < count; i++)
+		{
+			// Point buffers (squares are carried over to the next iteration)
+			double x = zr[i], y = zi[i], x2 = x*x, y2 = y*y;
+			double sx = x, sy = y, dx, dy;
+			unsigned n, save = 1;
+
+			// Captured orbits are compared against the fixed capture point (never saving)
+			if (params.capture) { sx = params.captureReal; sy = params.captureImag; save = 0; }
+			bool cycle = false;
+
+			// Iterative process
+			for (n = 0; n < params.maxIter; n++)
+			{
+				// Iteration function (z = z^2 + c)
+				y  = 2*x*y + ci[i];
+				x  = x2 - y2 + cr[i];
+				x2 = x*x;
+				y2 = y*y;
+
+				// Break if z goes to infinity (beyond space)
+				if (x2 + y2 >= BAILOUT) break;
+
+				// Break if z came back to the saved point (it is cycling)
+				dx = x - sx;
+				dy = y - sy;
+				if (dx*dx + dy*dy < tolerance) { cycle = true; break; }
+
+				// Save z at every power-of-two iteration (Brent)
+				if (n + 1 == save) { sx = x; sy = y; save <<= 1; }
+			}
+
+			// Escaping and cycling points also spend the iteration they stopped on
+			out[i] = cycle ? params.maxIter : n;
+			used  += n < params.maxIter ? n + 1 : n;
+		}
+
+		// One lane is always busy
+		stats.used   += used;
+		stats.issued += used;
+	}
+
+	/**
+	 * Selects the kernel with the given name to render with ("auto" selects
+	 * the fastest kernel supported by this cpu)
+	 *
+	 * @param name the name of the kernel
+	 *
+	 * @throw Error when name is not a kernel or is not supported by this cpu
+	 */
+	void selectKernel(string name) throw(Error)
+	{
+		// Find kernel
+		for (unsigned i = 0; i < KERNEL_COUNT; i++)
+		{
+			// Auto takes the first supported kernel
+			if (name == "auto" && kernels[i].supported())
+			{
+				selected = &kernels[i];
+				return;
+			}
+
+			if (name == kernels[i].name)
+			{
+				// Error if cpu does not support it
+				if (!kernels[i].supported())
+					throw Error("Kernel " + name + " is not supported by this cpu.");
+
+				// Select kernel
+				selected = &kernels[i];
+				return;
+			}
+		}
+
+		// Error if not found
+		throw Error("Undefined kernel name: " + name + ". See -help for available kernels.");
+	}
+
+	/**
+	 * Returns the name of the selected kernel
+	 *
+	 * @return the name of the selected kernel
+	 */
+	string getKernelName()
+	{
+		return selected->name;
+	}
+
+	/**
+	 * Selects the precision to render with ("float", "double", "double-double",
+	 * "fixed", "perturbation" or "auto", which picks the cheapest precision
+	 * from AUTO_PRECISION up that resolves the pixels of each image and tile)
+	 *
+	 * @param name the name of the precision
+	 *
+	 * @throw Error when name is not a precision
+	 */
+	void selectPrecision(string name) throw(Error)
+	{
+		// Auto picks for each image and tile
+		automatic = name == "auto";
+		if (automatic) return;
+
+		// Find precision
+		for (unsigned i = 0; i < PRECISION_COUNT; i++)
+		{
+			if (name == precisionNames[i])
+			{
+				precision = (Precision)i;
+				return;
+			}
+		}
+
+		// Error if not found
+		throw Error("Undefined precision name: " + name + ". See -help for available precisions.");
+	}
+
+	/**
+	 * Returns the name of the given precision
+	 *
+	 * @param precision the precision
+	 *
+	 * @return the name of the given precision
+	 */
+	string getPrecisionName(Precision precision)
+	{
+		return precisionNames[precision];
+	}
+
+	/**
+	 * Returns the cheapest precision that resolves the pixels in the given
+	 * region of the image, whose spacing must be PRECISION_MARGIN times the
+	 * rounding error of the largest point in the region (float, double, or
+	 * perturbation where neither does)
+	 *
+	 * @param trans  the image configuration
+	 * @param x      the x coord of the region
+	 * @param y      the y coord of the region
+	 * @param width  the width of the region
+	 * @param height the height of the region
+	 *
+	 * @return the cheapest precision that resolves the pixels in the region
+	 */
+	Precision resolvingPrecision(const Transform& trans, unsigned x, unsigned y, unsigned width, unsigned height)
+	{
+		// The largest point is at a corner (orbits reach a magnitude of 1
+		// wherever they start, so smaller points need as much precision)
+		double magnitude = 1;
+		magnitude = max(magnitude, abs(trans(x, y)));
+		magnitude = max(magnitude, abs(trans(x + width, y)));
+		magnitude = max(magnitude, abs(trans(x, y + height)));
+		magnitude = max(magnitude, abs(trans(x + width, y + height)));
+
+		// First precision whose rounding error is far enough below the spacing
+		for (unsigned i = 0; i < AUTO_COUNT; i++)
+			if (PRECISION_MARGIN * autoEpsilons[i] * magnitude <= trans.spacing())
+				return autoPrecisions[i];
+		return PERTURBATION_PRECISION;
+	}
+
+	/**
+	 * Returns the precision to render the image with the given transform in
+	 * (picked from its pixels if automatic)
+	 *
+	 * @param trans the image configuration
+	 *
+	 * @return the precision to render the image in
+	 */
+	static Precision imagePrecision(const Transform& trans)
+	{
+		if (!automatic) return precision;
+		return max(AUTO_PRECISION, resolvingPrecision(trans, 0, 0, trans.size.width, trans.size.height));
+	}
+
+	/**
+	 * Sets whether orbits are checked for cycles
+	 *
+	 * @param period true if orbits are to be checked for cycles
+	 */
+	void setPeriodicity(bool period)
+	{
+		periodicity = period;
+	}
+
+	/**
+	 * Sets the iteration limit (0 picks the limit from the zoom of each image)
+	 *
+	 * @param limit the iteration limit
+	 */
+	void setMaxIter(unsigned limit)
+	{
+		iterationLimit = limit;
+	}
+
+	/**
+	 * Returns the iteration limit for rendering with the given transform
+	 * (MAX_ITER plus AUTO_ITER_PER_OCTAVE for every doubling of the zoom in auto mode)
+	 *
+	 * @param trans the image configuration
+	 *
+	 * @return the iteration limit for rendering with the given transform
+	 */
+	unsigned maxIterations(const Transform& trans)
+	{
+		if (iterationLimit) return iterationLimit;
+		return MAX_ITER + (unsigned)(AUTO_ITER_PER_OCTAVE * max(0.0, log2(trans.zoom)));
+	}
+
+	/**
+	 * Sets the exponent d of the iteration function z = z^d + c
+	 *
+	 * @param d the exponent
+	 *
+	 * @throw Error when d is below 2
+	 */
+	void setExponent(double d) throw(Error)
+	{
+		// Below 2, points beyond the bailout circle do not always escape
+		if (!(d >= 2))
+		{
+			ostringstream str;
+			str << "Invalid exponent: " << d << ". Expected a number of at least 2.";
+			throw Error(str.str());
+		}
+		exponent = d;
+	}
+
+	/**
+	 * Selects the iteration function to render with ("standard",
+	 * "burning-ship", "tricorn", "phoenix", "exp", "sin" or "cos")
+	 *
+	 * @param name the name of the formula
+	 *
+	 * @throw Error when name is not a formula
+	 */
+	void selectFormula(string name) throw(Error)
+	{
+		// Find formula
+		for (unsigned i = 0; i < FORMULA_COUNT; i++)
+		{
+			if (name == formulaNames[i])
+			{
+				formula = (Formula)i;
+				return;
+			}
+		}
+
+		// Error if not found
+		throw Error("Undefined formula name: " + name + ". See -help for available formulas.");
+	}
+
+	/**
+	 * Returns the name of the given formula
+	 *
+	 * @param formula the formula
+	 *
+	 * @return the name of the given formula
+	 */
+	string getFormulaName(Formula formula)
+	{
+		return formulaNames[formula];
+	}
+
+	/**
+	 * Sets the constant p of the Phoenix formula
+	 *
+	 * @param p the constant p
+	 */
+	void setPhoenix(const complex<double>& p)
+	{
+		phoenix = p;
+	}
+
+	/**
+	 * Compiles the given formula of z and c to iterate points with instead
+	 * of the selected formula and exponent (empty goes back to them), and
+	 * builds it into native code if set to
+	 *
+	 * @param formula the iteration function of z and c
+	 *
+	 * @throw Error when the formula can not be compiled
+	 */
+	void setProgram(const string& formula) throw(Error)
+	{
+		program = formula.empty() ? Program() : Program(formula);
+		if (building && !program.source.empty())
+			native.load(program, nativeCache.empty() ? defaultNativeCache() : nativeCache);
+		else
+			native.unload();
+	}
+
+	/**
+	 * Sets whether programs are built into native code with the local
+	 * compiler (falling back to the program kernel if they can not be),
+	 * and the directory native builds are cached in
+	 *
+	 * @param build true if programs are to be built into native code
+	 * @param cache the directory native builds are cached in (the default if empty)
+	 */
+	void setNative(bool build, const string& cache)
+	{
+		building    = build;
+		nativeCache = cache;
+	}
+
+	/**
+	 * Returns why the program could not be built into native code
+	 *
+	 * @return why the program could not be built (empty if it was, or was not to be)
+	 */
+	string getNativeError()
+	{
+		return building && !program.source.empty() && !native.loaded() ? native.error() : "";
+	}
+
+	/**
+	 * Returns the kernel parameters for rendering with the given transform
+	 * (any formula but z^2 + c is always rendered in double, as only z^2 + c
+	 * has kernels in the other precisions, and Phoenix orbits are never
+	 * checked for cycles, as they depend on the previous z too)
+	 *
+	 * @param trans the image configuration
+	 *
+	 * @return the kernel parameters for rendering with the given transform
+	 */
+	KernelParams kernelParams(const Transform& trans)
+	{
+		bool period = periodicity && formula != PHOENIX_FORMULA;
+		KernelParams params(maxIterations(trans), period ? PERIOD_TOLERANCE * trans.spacing() : 0);
+		params.exponent    = exponent;
+		params.formula     = formula;
+		params.phoenixReal = phoenix.real();
+		params.phoenixImag = phoenix.imag();
+		params.program     = program.source.empty() ? 0 : &program;
+		params.native      = params.program && native.loaded() ? &native : 0;
+		params.precision   = params.standard() ? imagePrecision(trans) : DOUBLE_PRECISION;
+		params.automatic   = params.standard() && automatic;
+		return params;
+	}
+
+	/**
+	 * Sets whether julia set orbits are captured by the attracting cycle of c
+	 *
+	 * @param capture true if orbits are to be captured by the attracting cycle
+	 */
+	void setCapture(bool capture)
+	{
+		capturing = capture;
+	}
+
+	/**
+	 * Returns the kernel parameters for rendering the julia set of c with the
+	 * given transform (capturing orbits by the attracting cycle of c if it has one)
+	 *
+	 * @param trans the image configuration
+	 * @param c     the julia set complex constant
+	 *
+	 * @return the kernel parameters for rendering the julia set
+	 */
+	KernelParams kernelParams(const Transform& trans, const complex<double>& c)
+	{
+		// Fall back to plain periodicity detection without an attracting
+		// cycle (which is only looked for under z^2 + c)
+		Attractor attractor;
+		if (!capturing || !kernelParams(trans).standard() || !findAttractor(c, attractor))
+			return kernelParams(trans);
+
+		KernelParams params(maxIterations(trans), attractor);
+		params.precision = imagePrecision(trans);
+		params.automatic = automatic;
+		return params;
+	}
+
+	/**
+	 * Sets whether every batch is also computed with the reference kernel
+	 * and checked against it
+	 *
+	 * @param verify true if batches are to be verified
+	 */
+	void setVerify(bool verify)
+	{
+		verifying = verify;
+	}
+
+	/**
+	 * Returns true if batches are verified
+	 *
+	 * @return true if batches are verified
+	 */
+	bool getVerify()
+	{
+		return verifying;
+	}
+
+	/**
+	 * Returns true if float tiles are iterated as floats (the reference
+	 * kernel only iterates doubles, and verifying checks every batch against
+	 * it, so with either float tiles are rendered in double)
+	 *
+	 * @return true if float tiles are iterated as floats
+	 */
+	bool floatKernels()
+	{
+		// The reference kernel is last
+		return !verifying && selected != &kernels[KERNEL_COUNT - 1];
+	}
+
+	/**
+	 * Computes the batch with the selected kernel, checking it against the
+	 * reference kernel if verification is on (or with the formula kernel of
+	 * the selected kernel or the program kernel, unverified, if the formula
+	 * is not z^2 + c)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage and verification of the kernel (added to)
+	 */
+	template <typename Count>
+	void runKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		// Only z^2 + c has a reference
+		if (params.native)
+		{
+			nativeKernel(zr, zi, cr, ci, count, params, out, stats);
+			return;
+		}
+		if (params.program)
+		{
+			programKernel(zr, zi, cr, ci, count, params, out, stats);
+			return;
+		}
+		if (!params.standard())
+		{
+			formulaKernelFunction<Count>(*selected)(zr, zi, cr, ci, count, params, out, stats);
+			return;
+		}
+
+		// Run selected kernel
+		kernelFunction<Count>(*selected)(zr, zi, cr, ci, count, params, out, stats);
+		if (!verifying) return;
+
+		// Run reference kernel (its lane usage is not counted)
+		vector<Count> expected(count);
+		KernelStats ignored;
+		referenceKernel(zr, zi, cr, ci, count, params, &expected[0], ignored);
+
+		// Compare every point
+		for (unsigned i = 0; i < count; i++)
+		{
+			unsigned diff = out[i] > expected[i] ? out[i] - expected[i] : expected[i] - out[i];
+			if (diff > 0) stats.mismatched++;
+			if (diff > stats.maxDifference) stats.maxDifference = diff;
+		}
+		stats.checked += count;
+	}
+
+	/**
+	 * Computes the batch with the float kernel of the selected kernel (which
+	 * is never verified, as float tiles are rendered in double while verifying)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void runKernel(const float* zr, const float* zi,
+		const float* cr, const float* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		floatKernelFunction<Count>(*selected)(zr, zi, cr, ci, count, params, out, stats);
+	}
+
+	/**
+	 * Computes the batch with the double-double kernel (which is never verified,
+	 * as the reference kernel can not resolve the points)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void runKernel(const ddouble* zr, const ddouble* zi,
+		const ddouble* cr, const ddouble* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		ddKernel(zr, zi, cr, ci, count, params, out, stats);
+	}
+
+	/**
+	 * Computes the batch with the fixed-point kernel (which is never verified,
+	 * as the reference kernel can not resolve the points)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void runKernel(const fixed128* zr, const fixed128* zi,
+		const fixed128* cr, const fixed128* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		fixedKernel(zr, zi, cr, ci, count, params, out, stats);
+	}
+
+	/**
+	 * Returns the names of all of the kernels
+	 *
+	 * @return the names of all of the kernels
+	 */
+	vector<string> getKernels()
+	{
+		vector<string> names;
+		for (unsigned i = 0; i < KERNEL_COUNT; i++)
+			names.push_back(kernels[i].name);
+		return names;
+	}
+
+	// Kernels and runKernel for every count width
+	template void referenceKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void referenceKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void referenceKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+	template void scalarKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void scalarKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void scalarKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+	template void runKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void runKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void runKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+	template void runKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void runKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void runKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+	template void runKernel(const ddouble*, const ddouble*, const ddouble*, const ddouble*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void runKernel(const ddouble*, const ddouble*, const ddouble*, const ddouble*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void runKernel(const ddouble*, const ddouble*, const ddouble*, const ddouble*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+	template void runKernel(const fixed128*, const fixed128*, const fixed128*, const fixed128*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void runKernel(const fixed128*, const fixed128*, const fixed128*, const fixed128*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void runKernel(const fixed128*, const fixed128*, const fixed128*, const fixed128*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+}
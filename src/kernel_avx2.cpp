@@ -0,0 +1,663 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/kernel.h"
+
+// Libraries being used
+#include <immintrin.h>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * Computes the batch four points at a time with AVX2 and FMA
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx2,fma")))
+	void avx2Kernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		// Lane buffers (padding lanes start outside the bailout, so they escape at once)
+		double lzr[4], lzi[4], lcr[4], lci[4];
+		long long ln[4], lcycle[4];
+
+		// Constants
+		const __m256d bailout   = _mm256_set1_pd(BAILOUT);
+		const __m256d tolerance = _mm256_set1_pd(params.tolerance * params.tolerance);
+		const unsigned maxIter  = params.maxIter;
+
+		for (unsigned i = 0; i < count; i += 4)
+		{
+			// Load lanes
+			for (unsigned l = 0; l < 4; l++)
+			{
+				bool pad = i + l >= count;
+				lzr[l] = pad ? SCALE : zr[i + l];
+				lzi[l] = pad ? 0     : zi[i + l];
+				lcr[l] = pad ? SCALE : cr[i + l];
+				lci[l] = pad ? 0     : ci[i + l];
+			}
+			__m256d vzr = _mm256_loadu_pd(lzr);
+			__m256d vzi = _mm256_loadu_pd(lzi);
+			__m256d vcr = _mm256_loadu_pd(lcr);
+			__m256d vci = _mm256_loadu_pd(lci);
+
+			// Every lane starts active with zero iterations, saving its starting point
+			__m256d active = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+			__m256d cycled = _mm256_setzero_pd();
+			__m256i n = _mm256_setzero_si256();
+			__m256d vsr = vzr, vsi = vzi;
+			unsigned save = 1;
+
+			// Captured orbits are compared against the fixed capture point (never saving)
+			if (params.capture)
+			{
+				vsr  = _mm256_set1_pd(params.captureReal);
+				vsi  = _mm256_set1_pd(params.captureImag);
+				save = 0;
+			}
+
+			// Iterative process
+			unsigned k;
+			for (k = 0; k < maxIter; k++)
+			{
+				// Iteration function (z = z^2 + c)
+				__m256d zi2 = _mm256_mul_pd(vzi, vzi);
+				__m256d nzi = _mm256_fmadd_pd(_mm256_add_pd(vzr, vzr), vzi, vci);
+				vzr = _mm256_fmadd_pd(vzr, vzr, _mm256_sub_pd(vcr, zi2));
+				vzi = nzi;
+
+				// Mask off lanes that went to infinity (beyond space)
+				__m256d mag = _mm256_fmadd_pd(vzr, vzr, _mm256_mul_pd(vzi, vzi));
+				active = _mm256_and_pd(active, _mm256_cmp_pd(mag, bailout, _CMP_LT_OQ));
+
+				// Mask off lanes that came back to their saved point (they are cycling)
+				__m256d dr = _mm256_sub_pd(vzr, vsr), di = _mm256_sub_pd(vzi, vsi);
+				__m256d dist = _mm256_fmadd_pd(dr, dr, _mm256_mul_pd(di, di));
+				__m256d cycle = _mm256_and_pd(active, _mm256_cmp_pd(dist, tolerance, _CMP_LT_OQ));
+				cycled = _mm256_or_pd(cycled, cycle);
+				active = _mm256_andnot_pd(cycle, active);
+
+				// Count an iteration for every lane still active (mask is -1)
+				n = _mm256_sub_epi64(n, _mm256_castpd_si256(active));
+
+				// Break when every lane is done
+				if (_mm256_testz_pd(active, active)) break;
+
+				// Save z at every power-of-two iteration (Brent)
+				if (k + 1 == save) { vsr = vzr; vsi = vzi; save <<= 1; }
+			}
+
+			// Every lane is issued until the slowest lane is done
+			stats.issued += 4 * (k < maxIter ? k + 1 : k);
+
+			// Store iterations (escaping and cycling lanes also spent the iteration they stopped on)
+			_mm256_storeu_si256((__m256i*)ln, n);
+			_mm256_storeu_si256((__m256i*)lcycle, _mm256_castpd_si256(cycled));
+			for (unsigned l = 0; l < 4 && i + l < count; l++)
+			{
+				out[i + l]  = lcycle[l] ? maxIter : ln[l];
+				stats.used += ln[l] < maxIter ? ln[l] + 1 : ln[l];
+			}
+		}
+	}
+
+	/**
+	 * Computes the batch four points at a time with AVX2 and FMA, loading the
+	 * next point into a lane as soon as its point escapes, cycles or reaches the iteration limit
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx2,fma")))
+	void avx2RefillKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		// Lane buffers and the index of the point in each lane
+		double lzr[4], lzi[4], lcr[4], lci[4], lsr[4], lsi[4];
+		long long ln[4], llive[4], lcycle[4];
+		unsigned index[4];
+		unsigned long long issued = 0;
+
+		// Constants
+		const __m256d bailout   = _mm256_set1_pd(BAILOUT);
+		const __m256d tolerance = _mm256_set1_pd(params.tolerance * params.tolerance);
+		const __m256i maxiter   = _mm256_set1_epi64x(params.maxIter);
+		const __m256i one       = _mm256_set1_epi64x(1);
+		const __m256i zero      = _mm256_setzero_si256();
+		const __m256d saving    = _mm256_castsi256_pd(_mm256_set1_epi64x(params.capture ? 0 : -1));
+
+		// Load the first points (lanes without one stay dead)
+		unsigned next = 0, live = 0;
+		for (unsigned l = 0; l < 4; l++)
+		{
+			bool load = next < count;
+			index[l] = next;
+			lzr[l]   = load ? zr[next] : 0;
+			lzi[l]   = load ? zi[next] : 0;
+			lcr[l]   = load ? cr[next] : 0;
+			lci[l]   = load ? ci[next] : 0;
+			llive[l] = load ? -1 : 0;
+			ln[l]    = 0;
+			if (load) { next++; live++; }
+		}
+		__m256d vzr   = _mm256_loadu_pd(lzr);
+		__m256d vzi   = _mm256_loadu_pd(lzi);
+		__m256d vcr   = _mm256_loadu_pd(lcr);
+		__m256d vci   = _mm256_loadu_pd(lci);
+		__m256d vlive = _mm256_castsi256_pd(_mm256_loadu_si256((__m256i*)llive));
+		__m256i n     = _mm256_loadu_si256((__m256i*)ln);
+		__m256d vsr   = params.capture ? _mm256_set1_pd(params.captureReal) : vzr;
+		__m256d vsi   = params.capture ? _mm256_set1_pd(params.captureImag) : vzi;
+
+		// Iterate until every lane is dead
+		while (live > 0)
+		{
+			// Iteration function (z = z^2 + c)
+			__m256d zi2 = _mm256_mul_pd(vzi, vzi);
+			__m256d nzi = _mm256_fmadd_pd(_mm256_add_pd(vzr, vzr), vzi, vci);
+			vzr = _mm256_fmadd_pd(vzr, vzr, _mm256_sub_pd(vcr, zi2));
+			vzi = nzi;
+			issued += 4;
+
+			// Count an iteration for every live lane that did not go to infinity
+			__m256d mag     = _mm256_fmadd_pd(vzr, vzr, _mm256_mul_pd(vzi, vzi));
+			__m256d escaped = _mm256_and_pd(vlive, _mm256_cmp_pd(mag, bailout, _CMP_GE_OQ));
+			__m256d bounded = _mm256_andnot_pd(escaped, vlive);
+			n = _mm256_sub_epi64(n, _mm256_castpd_si256(bounded));
+
+			// Find lanes that came back to their saved point (they are cycling)
+			__m256d dr    = _mm256_sub_pd(vzr, vsr), di = _mm256_sub_pd(vzi, vsi);
+			__m256d dist  = _mm256_fmadd_pd(dr, dr, _mm256_mul_pd(di, di));
+			__m256d cycle = _mm256_and_pd(bounded, _mm256_cmp_pd(dist, tolerance, _CMP_LT_OQ));
+
+			// Save z in lanes at a power-of-two iteration (Brent, unless captured)
+			__m256d save = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(n, _mm256_sub_epi64(n, one)), zero));
+			save = _mm256_and_pd(save, saving);
+			vsr = _mm256_blendv_pd(vsr, vzr, save);
+			vsi = _mm256_blendv_pd(vsi, vzi, save);
+
+			// Lanes are done when they escape, cycle or reach the iteration limit
+			__m256d maxed = _mm256_and_pd(bounded, _mm256_castsi256_pd(_mm256_cmpeq_epi64(n, maxiter)));
+			int done = _mm256_movemask_pd(_mm256_or_pd(_mm256_or_pd(escaped, cycle), maxed));
+			if (!done) continue;
+
+			// Spill lanes
+			_mm256_storeu_pd(lzr, vzr);
+			_mm256_storeu_pd(lzi, vzi);
+			_mm256_storeu_pd(lcr, vcr);
+			_mm256_storeu_pd(lci, vci);
+			_mm256_storeu_si256((__m256i*)llive, _mm256_castpd_si256(vlive));
+			_mm256_storeu_si256((__m256i*)ln, n);
+			_mm256_storeu_pd(lsr, vsr);
+			_mm256_storeu_pd(lsi, vsi);
+			_mm256_storeu_si256((__m256i*)lcycle, _mm256_castpd_si256(cycle));
+			int esc = _mm256_movemask_pd(escaped);
+
+			// Write back finished points and refill their lanes
+			for (unsigned l = 0; l < 4; l++)
+			{
+				if (!(done & (1 << l))) continue;
+
+				// Write back (escaping points also spend the iteration they escaped on)
+				out[index[l]] = lcycle[l] ? params.maxIter : ln[l];
+				stats.used   += esc & (1 << l) ? ln[l] + 1 : ln[l];
+
+				// Load the next point or kill the lane
+				if (next < count)
+				{
+					index[l] = next;
+					lzr[l]   = zr[next];
+					lzi[l]   = zi[next];
+					lcr[l]   = cr[next];
+					lci[l]   = ci[next];
+					lsr[l]   = params.capture ? params.captureReal : zr[next];
+					lsi[l]   = params.capture ? params.captureImag : zi[next];
+					ln[l]    = 0;
+					next++;
+				}
+				else
+				{
+					llive[l] = 0;
+					live--;
+				}
+			}
+
+			// Reload lanes
+			vzr   = _mm256_loadu_pd(lzr);
+			vzi   = _mm256_loadu_pd(lzi);
+			vcr   = _mm256_loadu_pd(lcr);
+			vci   = _mm256_loadu_pd(lci);
+			vlive = _mm256_castsi256_pd(_mm256_loadu_si256((__m256i*)llive));
+			n     = _mm256_loadu_si256((__m256i*)ln);
+			vsr   = _mm256_loadu_pd(lsr);
+			vsi   = _mm256_loadu_pd(lsi);
+		}
+		stats.issued += issued;
+	}
+
+	/**
+	 * Computes the batch eight points at a time in float with AVX2 and FMA
+	 * (twice the lanes of the double kernel, for shallow zooms)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx2,fma")))
+	void avx2FloatKernel(const float* zr, const float* zi,
+		const float* cr, const float* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		// Lane buffers (padding lanes start outside the bailout, so they escape at once)
+		float lzr[8], lzi[8], lcr[8], lci[8];
+		int ln[8], lcycle[8];
+
+		// Constants
+		const __m256 bailout   = _mm256_set1_ps(BAILOUT);
+		const __m256 tolerance = _mm256_set1_ps(params.tolerance * params.tolerance);
+		const unsigned maxIter = params.maxIter;
+
+		for (unsigned i = 0; i < count; i += 8)
+		{
+			// Load lanes
+			for (unsigned l = 0; l < 8; l++)
+			{
+				bool pad = i + l >= count;
+				lzr[l] = pad ? SCALE : zr[i + l];
+				lzi[l] = pad ? 0     : zi[i + l];
+				lcr[l] = pad ? SCALE : cr[i + l];
+				lci[l] = pad ? 0     : ci[i + l];
+			}
+			__m256 vzr = _mm256_loadu_ps(lzr);
+			__m256 vzi = _mm256_loadu_ps(lzi);
+			__m256 vcr = _mm256_loadu_ps(lcr);
+			__m256 vci = _mm256_loadu_ps(lci);
+
+			// Every lane starts active with zero iterations, saving its starting point
+			__m256 active = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			__m256 cycled = _mm256_setzero_ps();
+			__m256i n = _mm256_setzero_si256();
+			__m256 vsr = vzr, vsi = vzi;
+			unsigned save = 1;
+
+			// Captured orbits are compared against the fixed capture point (never saving)
+			if (params.capture)
+			{
+				vsr  = _mm256_set1_ps(params.captureReal);
+				vsi  = _mm256_set1_ps(params.captureImag);
+				save = 0;
+			}
+
+			// Iterative process
+			unsigned k;
+			for (k = 0; k < maxIter; k++)
+			{
+				// Iteration function (z = z^2 + c)
+				__m256 zi2 = _mm256_mul_ps(vzi, vzi);
+				__m256 nzi = _mm256_fmadd_ps(_mm256_add_ps(vzr, vzr), vzi, vci);
+				vzr = _mm256_fmadd_ps(vzr, vzr, _mm256_sub_ps(vcr, zi2));
+				vzi = nzi;
+
+				// Mask off lanes that went to infinity (beyond space)
+				__m256 mag = _mm256_fmadd_ps(vzr, vzr, _mm256_mul_ps(vzi, vzi));
+				active = _mm256_and_ps(active, _mm256_cmp_ps(mag, bailout, _CMP_LT_OQ));
+
+				// Mask off lanes that came back to their saved point (they are cycling)
+				__m256 dr = _mm256_sub_ps(vzr, vsr), di = _mm256_sub_ps(vzi, vsi);
+				__m256 dist = _mm256_fmadd_ps(dr, dr, _mm256_mul_ps(di, di));
+				__m256 cycle = _mm256_and_ps(active, _mm256_cmp_ps(dist, tolerance, _CMP_LT_OQ));
+				cycled = _mm256_or_ps(cycled, cycle);
+				active = _mm256_andnot_ps(cycle, active);
+
+				// Count an iteration for every lane still active (mask is -1)
+				n = _mm256_sub_epi32(n, _mm256_castps_si256(active));
+
+				// Break when every lane is done
+				if (_mm256_testz_ps(active, active)) break;
+
+				// Save z at every power-of-two iteration (Brent)
+				if (k + 1 == save) { vsr = vzr; vsi = vzi; save <<= 1; }
+			}
+
+			// Every lane is issued until the slowest lane is done
+			stats.issued += 8 * (k < maxIter ? k + 1 : k);
+
+			// Store iterations (escaping and cycling lanes also spent the iteration they stopped on)
+			_mm256_storeu_si256((__m256i*)ln, n);
+			_mm256_storeu_si256((__m256i*)lcycle, _mm256_castps_si256(cycled));
+			for (unsigned l = 0; l < 8 && i + l < count; l++)
+			{
+				out[i + l]  = lcycle[l] ? maxIter : (unsigned)ln[l];
+				stats.used += (unsigned)ln[l] < maxIter ? ln[l] + 1 : ln[l];
+			}
+		}
+	}
+
+	/**
+	 * The Burning Ship iteration function z = (|Re z| + |Im z|i)^2 + c on four lanes
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct BurningShipLanes
+	{
+		/**
+		 * Creates BurningShipLanes
+		 *
+		 * @param params the kernel parameters
+		 */
+		BurningShipLanes(const KernelParams& params) {}
+
+		/**
+		 * Takes one iteration of z in every lane
+		 *
+		 * @param x  the real components of z (set)
+		 * @param y  the imaginary components of z (set)
+		 * @param ox the real components of the previous z (unused)
+		 * @param oy the imaginary components of the previous z (unused)
+		 * @param cr the real components of c
+		 * @param ci the imaginary components of c
+		 */
+		__attribute__((target("avx2,fma")))
+		inline void step(__m256d& x, __m256d& y, __m256d& ox, __m256d& oy, __m256d cr, __m256d ci) const
+		{
+			// The absolute value clears the sign bit (and the sign of 2|x||y| is never needed)
+			const __m256d sign = _mm256_set1_pd(-0.0);
+			__m256d ay = _mm256_andnot_pd(sign, y);
+			__m256d y2 = _mm256_mul_pd(y, y);
+			y = _mm256_fmadd_pd(_mm256_andnot_pd(sign, _mm256_add_pd(x, x)), ay, ci);
+			x = _mm256_fmadd_pd(x, x, _mm256_sub_pd(cr, y2));
+		}
+	};
+
+	/**
+	 * The Tricorn iteration function z = conj(z)^2 + c on four lanes
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct TricornLanes
+	{
+		/**
+		 * Creates TricornLanes
+		 *
+		 * @param params the kernel parameters
+		 */
+		TricornLanes(const KernelParams& params) {}
+
+		/**
+		 * Takes one iteration of z in every lane
+		 *
+		 * @param x  the real components of z (set)
+		 * @param y  the imaginary components of z (set)
+		 * @param ox the real components of the previous z (unused)
+		 * @param oy the imaginary components of the previous z (unused)
+		 * @param cr the real components of c
+		 * @param ci the imaginary components of c
+		 */
+		__attribute__((target("avx2,fma")))
+		inline void step(__m256d& x, __m256d& y, __m256d& ox, __m256d& oy, __m256d cr, __m256d ci) const
+		{
+			__m256d y2 = _mm256_mul_pd(y, y);
+			y = _mm256_fnmadd_pd(_mm256_add_pd(x, x), y, ci);
+			x = _mm256_fmadd_pd(x, x, _mm256_sub_pd(cr, y2));
+		}
+	};
+
+	/**
+	 * The Phoenix iteration function z = z^2 + c + p z' on four lanes, where
+	 * z' is the z before this one
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct PhoenixLanes
+	{
+		/**
+		 * The real component of p
+		 */
+		double pr;
+
+		/**
+		 * The imaginary component of p
+		 */
+		double pi;
+
+		/**
+		 * Creates PhoenixLanes
+		 *
+		 * @param params the kernel parameters (holding p)
+		 */
+		PhoenixLanes(const KernelParams& params):
+		pr(params.phoenixReal), pi(params.phoenixImag) {}
+
+		/**
+		 * Takes one iteration of z in every lane
+		 *
+		 * @param x  the real components of z (set)
+		 * @param y  the imaginary components of z (set)
+		 * @param ox the real components of the previous z (set)
+		 * @param oy the imaginary components of the previous z (set)
+		 * @param cr the real components of c
+		 * @param ci the imaginary components of c
+		 */
+		__attribute__((target("avx2,fma")))
+		inline void step(__m256d& x, __m256d& y, __m256d& ox, __m256d& oy, __m256d cr, __m256d ci) const
+		{
+			// c + p z'
+			const __m256d vpr = _mm256_set1_pd(pr), vpi = _mm256_set1_pd(pi);
+			__m256d ar = _mm256_fnmadd_pd(vpi, oy, _mm256_fmadd_pd(vpr, ox, cr));
+			__m256d ai = _mm256_fmadd_pd(vpi, ox, _mm256_fmadd_pd(vpr, oy, ci));
+
+			// z^2 + c + p z' (z becomes the previous z)
+			__m256d y2 = _mm256_mul_pd(y, y);
+			__m256d ny = _mm256_fmadd_pd(_mm256_add_pd(x, x), y, ai);
+			__m256d nx = _mm256_fmadd_pd(x, x, _mm256_sub_pd(ar, y2));
+			ox = x;
+			oy = y;
+			x  = nx;
+			y  = ny;
+		}
+	};
+
+	/**
+	 * Computes the batch four points at a time with AVX2 and FMA with the
+	 * iteration function of the given Formula (the driver every formula
+	 * with an exponent of 2 shares)
+	 *
+	 * @param zr      the real components of the starting points
+	 * @param zi      the imaginary components of the starting points
+	 * @param cr      the real components of the constants
+	 * @param ci      the imaginary components of the constants
+	 * @param count   the number of points in the batch
+	 * @param params  the kernel parameters
+	 * @param out     the number of iterations before infinity of each point
+	 * @param stats   the lane usage of the kernel (added to)
+	 * @param formula the iteration function
+	 */
+	template <typename Count, typename Formula>
+	__attribute__((target("avx2,fma")))
+	static void avx2FormulaDriver(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats, const Formula& formula)
+	{
+		// Lane buffers (padding lanes start outside the bailout, so they escape at once)
+		double lzr[4], lzi[4], lcr[4], lci[4];
+		long long ln[4], lcycle[4];
+
+		// Constants
+		const __m256d bailout   = _mm256_set1_pd(BAILOUT);
+		const __m256d tolerance = _mm256_set1_pd(params.tolerance * params.tolerance);
+		const unsigned maxIter  = params.maxIter;
+
+		for (unsigned i = 0; i < count; i += 4)
+		{
+			// Load lanes
+			for (unsigned l = 0; l < 4; l++)
+			{
+				bool pad = i + l >= count;
+				lzr[l] = pad ? SCALE : zr[i + l];
+				lzi[l] = pad ? 0     : zi[i + l];
+				lcr[l] = pad ? SCALE : cr[i + l];
+				lci[l] = pad ? 0     : ci[i + l];
+			}
+			__m256d vzr = _mm256_loadu_pd(lzr);
+			__m256d vzi = _mm256_loadu_pd(lzi);
+			__m256d vcr = _mm256_loadu_pd(lcr);
+			__m256d vci = _mm256_loadu_pd(lci);
+			__m256d vor = _mm256_setzero_pd(), voi = _mm256_setzero_pd();
+
+			// Every lane starts active with zero iterations, saving its starting point
+			__m256d active = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+			__m256d cycled = _mm256_setzero_pd();
+			__m256i n = _mm256_setzero_si256();
+			__m256d vsr = vzr, vsi = vzi;
+			unsigned save = 1;
+
+			// Iterative process
+			unsigned k;
+			for (k = 0; k < maxIter; k++)
+			{
+				// Iteration function
+				formula.step(vzr, vzi, vor, voi, vcr, vci);
+
+				// Mask off lanes that went to infinity (beyond space)
+				__m256d mag = _mm256_fmadd_pd(vzr, vzr, _mm256_mul_pd(vzi, vzi));
+				active = _mm256_and_pd(active, _mm256_cmp_pd(mag, bailout, _CMP_LT_OQ));
+
+				// Mask off lanes that came back to their saved point (they are cycling)
+				__m256d dr = _mm256_sub_pd(vzr, vsr), di = _mm256_sub_pd(vzi, vsi);
+				__m256d dist = _mm256_fmadd_pd(dr, dr, _mm256_mul_pd(di, di));
+				__m256d cycle = _mm256_and_pd(active, _mm256_cmp_pd(dist, tolerance, _CMP_LT_OQ));
+				cycled = _mm256_or_pd(cycled, cycle);
+				active = _mm256_andnot_pd(cycle, active);
+
+				// Count an iteration for every lane still active (mask is -1)
+				n = _mm256_sub_epi64(n, _mm256_castpd_si256(active));
+
+				// Break when every lane is done
+				if (_mm256_testz_pd(active, active)) break;
+
+				// Save z at every power-of-two iteration (Brent)
+				if (k + 1 == save) { vsr = vzr; vsi = vzi; save <<= 1; }
+			}
+
+			// Every lane is issued until the slowest lane is done
+			stats.issued += 4 * (k < maxIter ? k + 1 : k);
+
+			// Store iterations (escaping and cycling lanes also spent the iteration they stopped on)
+			_mm256_storeu_si256((__m256i*)ln, n);
+			_mm256_storeu_si256((__m256i*)lcycle, _mm256_castpd_si256(cycled));
+			for (unsigned l = 0; l < 4 && i + l < count; l++)
+			{
+				out[i + l]  = lcycle[l] ? maxIter : ln[l];
+				stats.used += ln[l] < maxIter ? ln[l] + 1 : ln[l];
+			}
+		}
+	}
+
+	/**
+	 * Computes the batch four points at a time with AVX2 and FMA with the
+	 * formula of the kernel parameters (with avx2TranscendentalKernel for
+	 * transcendental formulas, and formulaKernel if the exponent is not 2)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx2,fma")))
+	void avx2FormulaKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		// Transcendental formulas have their own vector kernel
+		if (params.transcendental())
+		{
+			avx2TranscendentalKernel(zr, zi, cr, ci, count, params, out, stats);
+			return;
+		}
+
+		// Other exponents are raised one point at a time
+		if (params.exponent != 2)
+		{
+			formulaKernel(zr, zi, cr, ci, count, params, out, stats);
+			return;
+		}
+
+		switch (params.formula)
+		{
+			case BURNING_SHIP_FORMULA:
+				avx2FormulaDriver(zr, zi, cr, ci, count, params, out, stats, BurningShipLanes(params));
+				break;
+			case TRICORN_FORMULA:
+				avx2FormulaDriver(zr, zi, cr, ci, count, params, out, stats, TricornLanes(params));
+				break;
+			case PHOENIX_FORMULA:
+				avx2FormulaDriver(zr, zi, cr, ci, count, params, out, stats, PhoenixLanes(params));
+				break;
+			default:
+				avx2Kernel(zr, zi, cr, ci, count, params, out, stats);
+				break;
+		}
+	}
+
+	// Kernels for every count width
+	template void avx2Kernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void avx2Kernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void avx2Kernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+
+	template void avx2RefillKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void avx2RefillKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void avx2RefillKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+
+	template void avx2FloatKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void avx2FloatKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void avx2FloatKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+
+	template void avx2FormulaKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void avx2FormulaKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void avx2FormulaKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+}
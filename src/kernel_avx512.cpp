@@ -0,0 +1,619 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/kernel.h"
+
+// Libraries being used
+#include <immintrin.h>
+#include <vector>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * Stores the iterations of the given lanes as unsigned
+	 *
+	 * @param out  the iterations to store to
+	 * @param mask the lanes to store
+	 * @param n    the iterations of each lane
+	 */
+	__attribute__((target("avx512f")))
+	static inline void storeCounts(unsigned* out, __mmask8 mask, __m512i n)
+	{
+		_mm512_mask_cvtepi64_storeu_epi32(out, mask, n);
+	}
+
+	/**
+	 * Stores the iterations of the given lanes as unsigned short
+	 *
+	 * @param out  the iterations to store to
+	 * @param mask the lanes to store
+	 * @param n    the iterations of each lane
+	 */
+	__attribute__((target("avx512f")))
+	static inline void storeCounts(unsigned short* out, __mmask8 mask, __m512i n)
+	{
+		_mm512_mask_cvtepi64_storeu_epi16(out, mask, n);
+	}
+
+	/**
+	 * Stores the iterations of the given lanes as unsigned char
+	 *
+	 * @param out  the iterations to store to
+	 * @param mask the lanes to store
+	 * @param n    the iterations of each lane
+	 */
+	__attribute__((target("avx512f")))
+	static inline void storeCounts(unsigned char* out, __mmask8 mask, __m512i n)
+	{
+		_mm512_mask_cvtepi64_storeu_epi8(out, mask, n);
+	}
+
+	/**
+	 * Stores the iterations of the given sixteen lanes as unsigned
+	 *
+	 * @param out  the iterations to store to
+	 * @param mask the lanes to store
+	 * @param n    the iterations of each lane
+	 */
+	__attribute__((target("avx512f")))
+	static inline void storeWideCounts(unsigned* out, __mmask16 mask, __m512i n)
+	{
+		_mm512_mask_storeu_epi32(out, mask, n);
+	}
+
+	/**
+	 * Stores the iterations of the given sixteen lanes as unsigned short
+	 *
+	 * @param out  the iterations to store to
+	 * @param mask the lanes to store
+	 * @param n    the iterations of each lane
+	 */
+	__attribute__((target("avx512f")))
+	static inline void storeWideCounts(unsigned short* out, __mmask16 mask, __m512i n)
+	{
+		_mm512_mask_cvtepi32_storeu_epi16(out, mask, n);
+	}
+
+	/**
+	 * Stores the iterations of the given sixteen lanes as unsigned char
+	 *
+	 * @param out  the iterations to store to
+	 * @param mask the lanes to store
+	 * @param n    the iterations of each lane
+	 */
+	__attribute__((target("avx512f")))
+	static inline void storeWideCounts(unsigned char* out, __mmask16 mask, __m512i n)
+	{
+		_mm512_mask_cvtepi32_storeu_epi8(out, mask, n);
+	}
+
+	/**
+	 * Returns the sum of the iterations of eight lanes (spilled and added one
+	 * at a time, as the reduce intrinsics warn of uninitialized use in GCC)
+	 *
+	 * @param n the iterations of each lane
+	 *
+	 * @return the sum of the iterations
+	 */
+	__attribute__((target("avx512f")))
+	static inline unsigned long long sumCounts(__m512i n)
+	{
+		unsigned long long lanes[8] __attribute__((aligned(64)));
+		_mm512_store_si512(lanes, n);
+		unsigned long long sum = 0;
+		for (unsigned l = 0; l < 8; l++)
+			sum += lanes[l];
+		return sum;
+	}
+
+	/**
+	 * Returns the sum of the iterations of sixteen lanes (spilled and added one
+	 * at a time, so that the sum can not overflow)
+	 *
+	 * @param n the iterations of each lane
+	 *
+	 * @return the sum of the iterations
+	 */
+	__attribute__((target("avx512f")))
+	static inline unsigned long long sumWideCounts(__m512i n)
+	{
+		unsigned lanes[16] __attribute__((aligned(64)));
+		_mm512_store_si512(lanes, n);
+		unsigned long long sum = 0;
+		for (unsigned l = 0; l < 16; l++)
+			sum += lanes[l];
+		return sum;
+	}
+
+	/**
+	 * Scatters the iterations of the given lanes to their indices as unsigned
+	 * (narrowed with the zero-masking form, as the plain narrowing intrinsic
+	 * warns of uninitialized use in GCC)
+	 *
+	 * @param out   the iterations to scatter to
+	 * @param mask  the lanes to scatter
+	 * @param index the index of the point in each lane
+	 * @param n     the iterations of each lane
+	 */
+	__attribute__((target("avx512f")))
+	static inline void scatterCounts(unsigned* out, __mmask8 mask, __m512i index, __m512i n)
+	{
+		_mm512_mask_i64scatter_epi32(out, mask, index, _mm512_maskz_cvtepi64_epi32(mask, n), 4);
+	}
+
+	/**
+	 * Scatters the iterations of the given sixteen lanes to their indices as unsigned
+	 *
+	 * @param out   the iterations to scatter to
+	 * @param mask  the lanes to scatter
+	 * @param index the index of the point in each lane
+	 * @param n     the iterations of each lane
+	 */
+	__attribute__((target("avx512f")))
+	static inline void scatterWideCounts(unsigned* out, __mmask16 mask, __m512i index, __m512i n)
+	{
+		_mm512_mask_i32scatter_epi32(out, mask, index, n, 4);
+	}
+
+	/**
+	 * Returns where a refill kernel scatters the iterations of the batch to,
+	 * which is the batch itself when it stores them as unsigned
+	 *
+	 * @param out   the iterations of the batch
+	 * @param count the number of points in the batch
+	 * @param wide  the buffer to scatter to otherwise (unused)
+	 *
+	 * @return where to scatter the iterations to
+	 */
+	static inline unsigned* wideCounts(unsigned* out, unsigned count, std::vector<unsigned>& wide)
+	{
+		return out;
+	}
+
+	/**
+	 * Returns where a refill kernel scatters the iterations of the batch to,
+	 * which is the given buffer when it stores them narrower than unsigned
+	 * (there is no narrower scatter, so they are narrowed once the batch is done)
+	 *
+	 * @param out   the iterations of the batch
+	 * @param count the number of points in the batch
+	 * @param wide  the buffer to scatter to (resized to the batch)
+	 *
+	 * @return where to scatter the iterations to
+	 */
+	template <typename Count>
+	static inline unsigned* wideCounts(Count* out, unsigned count, std::vector<unsigned>& wide)
+	{
+		wide.resize(count);
+		return &wide[0];
+	}
+
+	/**
+	 * Copies the iterations a refill kernel scattered back to the batch
+	 * (nothing to do when they were scattered to the batch itself)
+	 *
+	 * @param out   the iterations of the batch
+	 * @param wide  the iterations scattered
+	 * @param count the number of points in the batch
+	 */
+	static inline void narrowCounts(unsigned* out, const unsigned* wide, unsigned count) {}
+
+	/**
+	 * Copies the iterations a refill kernel scattered back to the batch,
+	 * sixteen at a time with down-converting stores
+	 *
+	 * @param out   the iterations of the batch
+	 * @param wide  the iterations scattered
+	 * @param count the number of points in the batch
+	 */
+	template <typename Count>
+	__attribute__((target("avx512f")))
+	static inline void narrowCounts(Count* out, const unsigned* wide, unsigned count)
+	{
+		for (unsigned i = 0; i < count; i += 16)
+		{
+			__mmask16 lanes = count - i < 16 ? (1 << (count - i)) - 1 : 0xFFFF;
+			storeWideCounts(out + i, lanes, _mm512_maskz_loadu_epi32(lanes, wide + i));
+		}
+	}
+
+	/**
+	 * Computes the batch eight points at a time with AVX-512
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx512f")))
+	void avx512Kernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		// Constants
+		const __m512d bailout   = _mm512_set1_pd(BAILOUT);
+		const __m512d tolerance = _mm512_set1_pd(params.tolerance * params.tolerance);
+		const __m512i maxiter   = _mm512_set1_epi64(params.maxIter);
+		const __m512i one       = _mm512_set1_epi64(1);
+		unsigned long long issued = 0;
+
+		for (unsigned i = 0; i < count; i += 8)
+		{
+			// Lanes past the end of the batch are never loaded or stored
+			__mmask8 lanes = count - i >= 8 ? 0xff : (1 << (count - i)) - 1;
+
+			// Load lanes
+			__m512d vzr = _mm512_maskz_loadu_pd(lanes, zr + i);
+			__m512d vzi = _mm512_maskz_loadu_pd(lanes, zi + i);
+			__m512d vcr = _mm512_maskz_loadu_pd(lanes, cr + i);
+			__m512d vci = _mm512_maskz_loadu_pd(lanes, ci + i);
+
+			// Every loaded lane starts active with zero iterations, saving its starting point
+			__mmask8 active = lanes;
+			__m512i n = _mm512_setzero_si512();
+			__m512d vsr = vzr, vsi = vzi;
+			unsigned save = 1;
+
+			// Captured orbits are compared against the fixed capture point (never saving)
+			if (params.capture)
+			{
+				vsr  = _mm512_set1_pd(params.captureReal);
+				vsi  = _mm512_set1_pd(params.captureImag);
+				save = 0;
+			}
+
+			// Iterative process (escaped and cycling lanes are frozen by the mask)
+			__mmask8 escaped = 0, cycled = 0;
+			for (unsigned k = 0; k < params.maxIter && active; k++)
+			{
+				// Iteration function (z = z^2 + c)
+				__m512d zi2 = _mm512_mul_pd(vzi, vzi);
+				__m512d nzi = _mm512_mask_fmadd_pd(_mm512_add_pd(vzr, vzr), active, vzi, vci);
+				vzr = _mm512_mask_fmadd_pd(vzr, active, vzr, _mm512_sub_pd(vcr, zi2));
+				vzi = _mm512_mask_mov_pd(vzi, active, nzi);
+
+				// Retire lanes that went to infinity (beyond space)
+				__m512d mag = _mm512_fmadd_pd(vzr, vzr, _mm512_mul_pd(vzi, vzi));
+				escaped |= _mm512_mask_cmp_pd_mask(active, mag, bailout, _CMP_GE_OQ);
+				active  &= ~escaped;
+				issued  += 8;
+
+				// Retire lanes that came back to their saved point (they are cycling)
+				__m512d dr = _mm512_sub_pd(vzr, vsr), di = _mm512_sub_pd(vzi, vsi);
+				__m512d dist = _mm512_fmadd_pd(dr, dr, _mm512_mul_pd(di, di));
+				cycled |= _mm512_mask_cmp_pd_mask(active, dist, tolerance, _CMP_LT_OQ);
+				active &= ~cycled;
+
+				// Count an iteration for every lane still active
+				n = _mm512_mask_add_epi64(n, active, n, one);
+
+				// Save z at every power-of-two iteration (Brent)
+				if (k + 1 == save) { vsr = vzr; vsi = vzi; save <<= 1; }
+			}
+
+			// Store iterations (escaping and cycling points also spend the iteration they stopped on)
+			storeCounts(out + i, lanes, _mm512_mask_mov_epi64(n, cycled, maxiter));
+			stats.used += sumCounts(_mm512_maskz_mov_epi64(lanes, n)) + __builtin_popcount(escaped | cycled);
+		}
+		stats.issued += issued;
+	}
+
+	/**
+	 * Computes the batch eight points at a time with AVX-512, expand-loading
+	 * the next points into lanes as soon as their points escape, cycle or reach the iteration limit
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx512f,bmi2")))
+	void avx512RefillKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		// Constants
+		const __m512d bailout   = _mm512_set1_pd(BAILOUT);
+		const __m512d tolerance = _mm512_set1_pd(params.tolerance * params.tolerance);
+		const __m512i maxiter   = _mm512_set1_epi64(params.maxIter);
+		const __m512i one       = _mm512_set1_epi64(1);
+		const __m512i lane      = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+		const __mmask8 saving   = params.capture ? 0 : 0xFF;
+
+		// Load the first points (lanes without one stay dead)
+		unsigned next  = count < 8 ? count : 8;
+		__mmask8 live  = (1 << next) - 1;
+		__m512d vzr    = _mm512_maskz_loadu_pd(live, zr);
+		__m512d vzi    = _mm512_maskz_loadu_pd(live, zi);
+		__m512d vcr    = _mm512_maskz_loadu_pd(live, cr);
+		__m512d vci    = _mm512_maskz_loadu_pd(live, ci);
+		__m512d vsr    = params.capture ? _mm512_set1_pd(params.captureReal) : vzr;
+		__m512d vsi    = params.capture ? _mm512_set1_pd(params.captureImag) : vzi;
+		__m512i index  = lane;
+		__m512i n      = _mm512_setzero_si512();
+		unsigned long long issued = 0;
+
+		// Iterations are scattered as unsigned
+		std::vector<unsigned> wide;
+		unsigned* counts = wideCounts(out, count, wide);
+
+		// Iterate until every lane is dead
+		while (live)
+		{
+			// Iteration function (z = z^2 + c)
+			__m512d zi2 = _mm512_mul_pd(vzi, vzi);
+			__m512d nzi = _mm512_fmadd_pd(_mm512_add_pd(vzr, vzr), vzi, vci);
+			vzr = _mm512_fmadd_pd(vzr, vzr, _mm512_sub_pd(vcr, zi2));
+			vzi = nzi;
+			issued += 8;
+
+			// Count an iteration for every live lane that did not go to infinity
+			__m512d mag      = _mm512_fmadd_pd(vzr, vzr, _mm512_mul_pd(vzi, vzi));
+			__mmask8 escaped = _mm512_mask_cmp_pd_mask(live, mag, bailout, _CMP_GE_OQ);
+			__mmask8 bounded = live & ~escaped;
+			n = _mm512_mask_add_epi64(n, bounded, n, one);
+
+			// Find lanes that came back to their saved point (they are cycling)
+			__m512d dr     = _mm512_sub_pd(vzr, vsr), di = _mm512_sub_pd(vzi, vsi);
+			__m512d dist   = _mm512_fmadd_pd(dr, dr, _mm512_mul_pd(di, di));
+			__mmask8 cycle = _mm512_mask_cmp_pd_mask(bounded, dist, tolerance, _CMP_LT_OQ);
+
+			// Save z in lanes at a power-of-two iteration (Brent, unless captured)
+			__mmask8 save = _mm512_mask_testn_epi64_mask(bounded & saving, n, _mm512_sub_epi64(n, one));
+			vsr = _mm512_mask_mov_pd(vsr, save, vzr);
+			vsi = _mm512_mask_mov_pd(vsi, save, vzi);
+
+			// Lanes are done when they escape, cycle or reach the iteration limit
+			__mmask8 done = escaped | cycle | _mm512_mask_cmpeq_epi64_mask(bounded, n, maxiter);
+			if (!done) continue;
+
+			// Scatter finished points back (escaping points also spend the iteration they escaped on)
+			scatterCounts(counts, done, index, _mm512_mask_mov_epi64(n, cycle, maxiter));
+			stats.used += sumCounts(_mm512_maskz_mov_epi64(done, n)) + __builtin_popcount(escaped);
+
+			// Expand-load the next points into the first finished lanes
+			unsigned avail  = count - next;
+			unsigned finish = __builtin_popcount(done);
+			unsigned take   = finish < avail ? finish : avail;
+			__mmask8 refill = _pdep_u32((1u << take) - 1, done);
+			vzr   = _mm512_mask_expandloadu_pd(vzr, refill, zr + next);
+			vzi   = _mm512_mask_expandloadu_pd(vzi, refill, zi + next);
+			vcr   = _mm512_mask_expandloadu_pd(vcr, refill, cr + next);
+			vci   = _mm512_mask_expandloadu_pd(vci, refill, ci + next);
+			vsr   = _mm512_mask_expandloadu_pd(vsr, refill & saving, zr + next);
+			vsi   = _mm512_mask_expandloadu_pd(vsi, refill & saving, zi + next);
+			index = _mm512_mask_expand_epi64(index, refill, _mm512_add_epi64(lane, _mm512_set1_epi64(next)));
+			n     = _mm512_mask_mov_epi64(n, refill, _mm512_setzero_si512());
+			live  = (live & ~done) | refill;
+			next += take;
+		}
+		narrowCounts(out, counts, count);
+		stats.issued += issued;
+	}
+
+	/**
+	 * Computes the batch sixteen points at a time in float with AVX-512
+	 * (twice the lanes of the double kernel, for shallow zooms)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx512f")))
+	void avx512FloatKernel(const float* zr, const float* zi,
+		const float* cr, const float* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		// Constants
+		const __m512 bailout   = _mm512_set1_ps(BAILOUT);
+		const __m512 tolerance = _mm512_set1_ps(params.tolerance * params.tolerance);
+		const __m512i maxiter  = _mm512_set1_epi32(params.maxIter);
+		const __m512i one      = _mm512_set1_epi32(1);
+		unsigned long long issued = 0;
+
+		for (unsigned i = 0; i < count; i += 16)
+		{
+			// Lanes past the end of the batch are never loaded or stored
+			__mmask16 lanes = count - i >= 16 ? 0xffff : (1 << (count - i)) - 1;
+
+			// Load lanes
+			__m512 vzr = _mm512_maskz_loadu_ps(lanes, zr + i);
+			__m512 vzi = _mm512_maskz_loadu_ps(lanes, zi + i);
+			__m512 vcr = _mm512_maskz_loadu_ps(lanes, cr + i);
+			__m512 vci = _mm512_maskz_loadu_ps(lanes, ci + i);
+
+			// Every loaded lane starts active with zero iterations, saving its starting point
+			__mmask16 active = lanes;
+			__m512i n = _mm512_setzero_si512();
+			__m512 vsr = vzr, vsi = vzi;
+			unsigned save = 1;
+
+			// Captured orbits are compared against the fixed capture point (never saving)
+			if (params.capture)
+			{
+				vsr  = _mm512_set1_ps(params.captureReal);
+				vsi  = _mm512_set1_ps(params.captureImag);
+				save = 0;
+			}
+
+			// Iterative process (escaped and cycling lanes are frozen by the mask)
+			__mmask16 escaped = 0, cycled = 0;
+			for (unsigned k = 0; k < params.maxIter && active; k++)
+			{
+				// Iteration function (z = z^2 + c)
+				__m512 zi2 = _mm512_mul_ps(vzi, vzi);
+				__m512 nzi = _mm512_mask_fmadd_ps(_mm512_add_ps(vzr, vzr), active, vzi, vci);
+				vzr = _mm512_mask_fmadd_ps(vzr, active, vzr, _mm512_sub_ps(vcr, zi2));
+				vzi = _mm512_mask_mov_ps(vzi, active, nzi);
+
+				// Retire lanes that went to infinity (beyond space)
+				__m512 mag = _mm512_fmadd_ps(vzr, vzr, _mm512_mul_ps(vzi, vzi));
+				escaped |= _mm512_mask_cmp_ps_mask(active, mag, bailout, _CMP_GE_OQ);
+				active  &= ~escaped;
+				issued  += 16;
+
+				// Retire lanes that came back to their saved point (they are cycling)
+				__m512 dr = _mm512_sub_ps(vzr, vsr), di = _mm512_sub_ps(vzi, vsi);
+				__m512 dist = _mm512_fmadd_ps(dr, dr, _mm512_mul_ps(di, di));
+				cycled |= _mm512_mask_cmp_ps_mask(active, dist, tolerance, _CMP_LT_OQ);
+				active &= ~cycled;
+
+				// Count an iteration for every lane still active
+				n = _mm512_mask_add_epi32(n, active, n, one);
+
+				// Save z at every power-of-two iteration (Brent)
+				if (k + 1 == save) { vsr = vzr; vsi = vzi; save <<= 1; }
+			}
+
+			// Store iterations (escaping and cycling points also spend the iteration they stopped on)
+			storeWideCounts(out + i, lanes, _mm512_mask_mov_epi32(n, cycled, maxiter));
+			stats.used += sumWideCounts(n) + __builtin_popcount(escaped | cycled);
+		}
+		stats.issued += issued;
+	}
+
+	/**
+	 * Computes the batch sixteen points at a time in float with AVX-512,
+	 * expand-loading the next points into lanes as soon as their points
+	 * escape, cycle or reach the iteration limit
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx512f,bmi2")))
+	void avx512FloatRefillKernel(const float* zr, const float* zi,
+		const float* cr, const float* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		// Constants
+		const __m512 bailout    = _mm512_set1_ps(BAILOUT);
+		const __m512 tolerance  = _mm512_set1_ps(params.tolerance * params.tolerance);
+		const __m512i maxiter   = _mm512_set1_epi32(params.maxIter);
+		const __m512i one       = _mm512_set1_epi32(1);
+		const __m512i lane      = _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+		const __mmask16 saving  = params.capture ? 0 : 0xFFFF;
+
+		// Load the first points (lanes without one stay dead)
+		unsigned next  = count < 16 ? count : 16;
+		__mmask16 live = (1 << next) - 1;
+		__m512 vzr     = _mm512_maskz_loadu_ps(live, zr);
+		__m512 vzi     = _mm512_maskz_loadu_ps(live, zi);
+		__m512 vcr     = _mm512_maskz_loadu_ps(live, cr);
+		__m512 vci     = _mm512_maskz_loadu_ps(live, ci);
+		__m512 vsr     = params.capture ? _mm512_set1_ps(params.captureReal) : vzr;
+		__m512 vsi     = params.capture ? _mm512_set1_ps(params.captureImag) : vzi;
+		__m512i index  = lane;
+		__m512i n      = _mm512_setzero_si512();
+		unsigned long long issued = 0;
+
+		// Iterations are scattered as unsigned
+		std::vector<unsigned> wide;
+		unsigned* counts = wideCounts(out, count, wide);
+
+		// Iterate until every lane is dead
+		while (live)
+		{
+			// Iteration function (z = z^2 + c)
+			__m512 zi2 = _mm512_mul_ps(vzi, vzi);
+			__m512 nzi = _mm512_fmadd_ps(_mm512_add_ps(vzr, vzr), vzi, vci);
+			vzr = _mm512_fmadd_ps(vzr, vzr, _mm512_sub_ps(vcr, zi2));
+			vzi = nzi;
+			issued += 16;
+
+			// Count an iteration for every live lane that did not go to infinity
+			__m512 mag        = _mm512_fmadd_ps(vzr, vzr, _mm512_mul_ps(vzi, vzi));
+			__mmask16 escaped = _mm512_mask_cmp_ps_mask(live, mag, bailout, _CMP_GE_OQ);
+			__mmask16 bounded = live & ~escaped;
+			n = _mm512_mask_add_epi32(n, bounded, n, one);
+
+			// Find lanes that came back to their saved point (they are cycling)
+			__m512 dr       = _mm512_sub_ps(vzr, vsr), di = _mm512_sub_ps(vzi, vsi);
+			__m512 dist     = _mm512_fmadd_ps(dr, dr, _mm512_mul_ps(di, di));
+			__mmask16 cycle = _mm512_mask_cmp_ps_mask(bounded, dist, tolerance, _CMP_LT_OQ);
+
+			// Save z in lanes at a power-of-two iteration (Brent, unless captured)
+			__mmask16 save = _mm512_mask_testn_epi32_mask(bounded & saving, n, _mm512_sub_epi32(n, one));
+			vsr = _mm512_mask_mov_ps(vsr, save, vzr);
+			vsi = _mm512_mask_mov_ps(vsi, save, vzi);
+
+			// Lanes are done when they escape, cycle or reach the iteration limit
+			__mmask16 done = escaped | cycle | _mm512_mask_cmpeq_epi32_mask(bounded, n, maxiter);
+			if (!done) continue;
+
+			// Scatter finished points back (escaping points also spend the iteration they escaped on)
+			scatterWideCounts(counts, done, index, _mm512_mask_mov_epi32(n, cycle, maxiter));
+			stats.used += sumWideCounts(_mm512_maskz_mov_epi32(done, n)) + __builtin_popcount(escaped);
+
+			// Expand-load the next points into the first finished lanes
+			unsigned avail   = count - next;
+			unsigned finish  = __builtin_popcount(done);
+			unsigned take    = finish < avail ? finish : avail;
+			__mmask16 refill = _pdep_u32((1u << take) - 1, done);
+			vzr   = _mm512_mask_expandloadu_ps(vzr, refill, zr + next);
+			vzi   = _mm512_mask_expandloadu_ps(vzi, refill, zi + next);
+			vcr   = _mm512_mask_expandloadu_ps(vcr, refill, cr + next);
+			vci   = _mm512_mask_expandloadu_ps(vci, refill, ci + next);
+			vsr   = _mm512_mask_expandloadu_ps(vsr, refill & saving, zr + next);
+			vsi   = _mm512_mask_expandloadu_ps(vsi, refill & saving, zi + next);
+			index = _mm512_mask_expand_epi32(index, refill, _mm512_add_epi32(lane, _mm512_set1_epi32(next)));
+			n     = _mm512_mask_mov_epi32(n, refill, _mm512_setzero_si512());
+			live  = (live & ~done) | refill;
+			next += take;
+		}
+		narrowCounts(out, counts, count);
+		stats.issued += issued;
+	}
+
+	// Kernels for every count width
+	template void avx512Kernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void avx512Kernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void avx512Kernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+
+	template void avx512RefillKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void avx512RefillKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void avx512RefillKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+
+	template void avx512FloatKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void avx512FloatKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void avx512FloatKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+
+	template void avx512FloatRefillKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void avx512FloatRefillKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void avx512FloatRefillKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+}
@@ -0,0 +1,118 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/kernel.h"
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * Computes the batch one point at a time in 128-bit fixed point, which
+	 * gives exactly the same iterations on every machine. Points whose start
+	 * or constant lies outside the square of side 4 about zero can not be
+	 * held, and are computed with the scalar kernel instead (as are starts
+	 * outside the bailout circle whose constant is outside it too).
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void fixedKernel(const fixed128* zr, const fixed128* zi,
+		const fixed128* cr, const fixed128* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		const double tolerance = params.tolerance * params.tolerance;
+		const fixed128 four(4.0);
+		unsigned long long used = 0;
+		for (unsigned i = 0; i < count; i++)
+		{
+			// Every number stays below 8 as long as the start and constant are
+			// below 2 and only points inside the bailout circle are squared
+			bool held = below(zr[i], 2) && below(zi[i], 2) && below(cr[i], 2) && below(ci[i], 2);
+
+			// Point buffers (squares are carried over to the next iteration)
+			fixed128 x = zr[i], y = zi[i], x2, y2;
+			fixed128 sx = x, sy = y;
+			double dx, dy;
+			unsigned n, save = 1;
+			bool cycle = false;
+			if (held) { x2 = x*x; y2 = y*y; }
+
+			// A start on or outside the bailout circle escapes on the first
+			// iteration when c is inside it (|z^2 + c| >= |z|^2 - |c| >= 2)
+			bool outside = held && (x2 + y2).raw >= four.raw;
+			if (outside && (cr[i]*cr[i] + ci[i]*ci[i]).raw <= four.raw)
+			{
+				out[i] = 0;
+				used++;
+				continue;
+			}
+
+			// Points that can not be held are computed in double instead
+			if (!held || outside)
+			{
+				double a = zr[i].toDouble(), b = zi[i].toDouble(), c = cr[i].toDouble(), d = ci[i].toDouble();
+				scalarKernel(&a, &b, &c, &d, 1, params, out + i, stats);
+				continue;
+			}
+
+			// Captured orbits are compared against the fixed capture point (never saving)
+			if (params.capture) { sx = params.captureReal; sy = params.captureImag; save = 0; }
+
+			// Iterative process
+			for (n = 0; n < params.maxIter; n++)
+			{
+				// Iteration function (z = z^2 + c)
+				y = twice(x*y) + ci[i];
+				x = x2 - y2 + cr[i];
+
+				// Break if z goes to infinity (beyond space, which is certain
+				// beyond the square, before its squares could overflow)
+				if (!below(x, 2) || !below(y, 2)) break;
+				x2 = x*x;
+				y2 = y*y;
+				if ((x2 + y2).raw >= four.raw) break;
+
+				// Break if z came back to the saved point (it is cycling, which
+				// is judged in double as the tolerance is below a fixed128)
+				dx = (x - sx).toDouble();
+				dy = (y - sy).toDouble();
+				if (dx*dx + dy*dy < tolerance) { cycle = true; break; }
+
+				// Save z at every power-of-two iteration (Brent)
+				if (n + 1 == save) { sx = x; sy = y; save <<= 1; }
+			}
+
+			// Escaping and cycling points also spend the iteration they stopped on
+			out[i] = cycle ? params.maxIter : n;
+			used  += n < params.maxIter ? n + 1 : n;
+		}
+
+		// One lane is always busy
+		stats.used   += used;
+		stats.issued += used;
+	}
+
+	// Kernel for every count width
+	template void fixedKernel(const fixed128*, const fixed128*, const fixed128*, const fixed128*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void fixedKernel(const fixed128*, const fixed128*, const fixed128*, const fixed128*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void fixedKernel(const fixed128*, const fixed128*, const fixed128*, const fixed128*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+}
@@ -0,0 +1,88 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/kernel.h"
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * Computes the batch one point at a time in float, for shallow zooms where
+	 * neighbouring pixels are far enough apart for a float to resolve
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void floatKernel(const float* zr, const float* zi,
+		const float* cr, const float* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		const float tolerance = params.tolerance * params.tolerance;
+		const float bailout   = BAILOUT;
+		unsigned long long used = 0;
+		for (unsigned i = 0; i < count; i++)
+		{
+			// Point buffers (squares are carried over to the next iteration)
+			float x = zr[i], y = zi[i], x2 = x*x, y2 = y*y;
+			float sx = x, sy = y, dx, dy;
+			unsigned n, save = 1;
+			bool cycle = false;
+
+			// Captured orbits are compared against the fixed capture point (never saving)
+			if (params.capture) { sx = params.captureReal; sy = params.captureImag; save = 0; }
+
+			// Iterative process
+			for (n = 0; n < params.maxIter; n++)
+			{
+				// Iteration function (z = z^2 + c)
+				y  = 2*x*y + ci[i];
+				x  = x2 - y2 + cr[i];
+				x2 = x*x;
+				y2 = y*y;
+
+				// Break if z goes to infinity (beyond space)
+				if (x2 + y2 >= bailout) break;
+
+				// Break if z came back to the saved point (it is cycling)
+				dx = x - sx;
+				dy = y - sy;
+				if (dx*dx + dy*dy < tolerance) { cycle = true; break; }
+
+				// Save z at every power-of-two iteration (Brent)
+				if (n + 1 == save) { sx = x; sy = y; save <<= 1; }
+			}
+
+			// Escaping and cycling points also spend the iteration they stopped on
+			out[i] = cycle ? params.maxIter : n;
+			used  += n < params.maxIter ? n + 1 : n;
+		}
+
+		// One lane is always busy
+		stats.used   += used;
+		stats.issued += used;
+	}
+
+	// Kernel for every count width
+	template void floatKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void floatKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void floatKernel(const float*, const float*, const float*, const float*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+}
@@ -0,0 +1,477 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/kernel.h"
+
+// Libraries being used
+#include <cmath>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * Raises a complex number to a whole power with a chain of complex
+	 * multiplies unrolled at compile time (squaring wherever the power is even)
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	template <unsigned Degree>
+	struct Power
+	{
+		/**
+		 * Raises x + yi to the power of Degree
+		 *
+		 * @param x  the real component of the number
+		 * @param y  the imaginary component of the number
+		 * @param px the real component of the power (set)
+		 * @param py the imaginary component of the power (set)
+		 */
+		static inline void raise(double x, double y, double& px, double& py)
+		{
+			double ax, ay;
+			if (Degree % 2 == 0)
+			{
+				// z^2k = (z^k)^2
+				Power<Degree / 2>::raise(x, y, ax, ay);
+				px = ax*ax - ay*ay;
+				py = 2*ax*ay;
+			}
+			else
+			{
+				// z^(k+1) = z^k z
+				Power<Degree - 1>::raise(x, y, ax, ay);
+				px = ax*x - ay*y;
+				py = ax*y + ay*x;
+			}
+		}
+	};
+
+	/**
+	 * Raises a complex number to the power of one (ends the chain)
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	template <>
+	struct Power<1>
+	{
+		/**
+		 * Raises x + yi to the power of one
+		 *
+		 * @param x  the real component of the number
+		 * @param y  the imaginary component of the number
+		 * @param px the real component of the power (set)
+		 * @param py the imaginary component of the power (set)
+		 */
+		static inline void raise(double x, double y, double& px, double& py)
+		{
+			px = x;
+			py = y;
+		}
+	};
+
+	/**
+	 * Raises a complex number to any real power through its polar form
+	 * (one pow, atan2, cos and sin, where std::pow on a complex also takes
+	 * a complex log and exp)
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct PolarPower
+	{
+		/**
+		 * The power numbers are raised to
+		 */
+		double exponent;
+
+		/**
+		 * Creates a PolarPower to the given power
+		 *
+		 * @param exponent the power numbers are raised to
+		 */
+		PolarPower(double exponent): exponent(exponent) {}
+
+		/**
+		 * Raises x + yi to the power (zero stays zero)
+		 *
+		 * @param x  the real component of the number
+		 * @param y  the imaginary component of the number
+		 * @param px the real component of the power (set)
+		 * @param py the imaginary component of the power (set)
+		 */
+		inline void raise(double x, double y, double& px, double& py) const
+		{
+			double r2 = x*x + y*y;
+			if (r2 == 0) { px = py = 0; return; }
+			double r = pow(r2, 0.5*exponent), t = exponent*atan2(y, x);
+			px = r*cos(t);
+			py = r*sin(t);
+		}
+	};
+
+	/**
+	 * Raises a complex number to the whole power Degree (so that kernels take
+	 * either power the same way)
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	template <unsigned Degree>
+	struct WholePower
+	{
+		/**
+		 * Raises x + yi to the power of Degree
+		 *
+		 * @param x  the real component of the number
+		 * @param y  the imaginary component of the number
+		 * @param px the real component of the power (set)
+		 * @param py the imaginary component of the power (set)
+		 */
+		inline void raise(double x, double y, double& px, double& py) const
+		{
+			Power<Degree>::raise(x, y, px, py);
+		}
+	};
+
+	/**
+	 * The iteration function z = z^d + c
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	template <typename Raise>
+	struct StandardFormula
+	{
+		/**
+		 * Raises z to the power of d
+		 */
+		Raise power;
+
+		/**
+		 * Creates a StandardFormula raising z with the given power
+		 *
+		 * @param power  raises z to the power of d
+		 * @param params the kernel parameters
+		 */
+		StandardFormula(const Raise& power, const KernelParams& params): power(power) {}
+
+		/**
+		 * Takes one iteration of z
+		 *
+		 * @param x  the real component of z (set)
+		 * @param y  the imaginary component of z (set)
+		 * @param ox the real component of the previous z (unused)
+		 * @param oy the imaginary component of the previous z (unused)
+		 * @param cr the real component of c
+		 * @param ci the imaginary component of c
+		 */
+		inline void step(double& x, double& y, double& ox, double& oy, double cr, double ci) const
+		{
+			double px, py;
+			power.raise(x, y, px, py);
+			x = px + cr;
+			y = py + ci;
+		}
+	};
+
+	/**
+	 * The Burning Ship iteration function z = (|Re z| + |Im z|i)^d + c
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	template <typename Raise>
+	struct BurningShipFormula
+	{
+		/**
+		 * Raises z to the power of d
+		 */
+		Raise power;
+
+		/**
+		 * Creates a BurningShipFormula raising z with the given power
+		 *
+		 * @param power  raises z to the power of d
+		 * @param params the kernel parameters
+		 */
+		BurningShipFormula(const Raise& power, const KernelParams& params): power(power) {}
+
+		/**
+		 * Takes one iteration of z
+		 *
+		 * @param x  the real component of z (set)
+		 * @param y  the imaginary component of z (set)
+		 * @param ox the real component of the previous z (unused)
+		 * @param oy the imaginary component of the previous z (unused)
+		 * @param cr the real component of c
+		 * @param ci the imaginary component of c
+		 */
+		inline void step(double& x, double& y, double& ox, double& oy, double cr, double ci) const
+		{
+			double px, py;
+			power.raise(fabs(x), fabs(y), px, py);
+			x = px + cr;
+			y = py + ci;
+		}
+	};
+
+	/**
+	 * The Tricorn iteration function z = conj(z)^d + c
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	template <typename Raise>
+	struct TricornFormula
+	{
+		/**
+		 * Raises z to the power of d
+		 */
+		Raise power;
+
+		/**
+		 * Creates a TricornFormula raising z with the given power
+		 *
+		 * @param power  raises z to the power of d
+		 * @param params the kernel parameters
+		 */
+		TricornFormula(const Raise& power, const KernelParams& params): power(power) {}
+
+		/**
+		 * Takes one iteration of z
+		 *
+		 * @param x  the real component of z (set)
+		 * @param y  the imaginary component of z (set)
+		 * @param ox the real component of the previous z (unused)
+		 * @param oy the imaginary component of the previous z (unused)
+		 * @param cr the real component of c
+		 * @param ci the imaginary component of c
+		 */
+		inline void step(double& x, double& y, double& ox, double& oy, double cr, double ci) const
+		{
+			double px, py;
+			power.raise(x, -y, px, py);
+			x = px + cr;
+			y = py + ci;
+		}
+	};
+
+	/**
+	 * The Phoenix iteration function z = z^d + c + p z', where z' is the z
+	 * before this one (zero at the start)
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	template <typename Raise>
+	struct PhoenixFormula
+	{
+		/**
+		 * Raises z to the power of d
+		 */
+		Raise power;
+
+		/**
+		 * The real component of p
+		 */
+		double pr;
+
+		/**
+		 * The imaginary component of p
+		 */
+		double pi;
+
+		/**
+		 * Creates a PhoenixFormula raising z with the given power
+		 *
+		 * @param power  raises z to the power of d
+		 * @param params the kernel parameters (holding p)
+		 */
+		PhoenixFormula(const Raise& power, const KernelParams& params):
+		power(power), pr(params.phoenixReal), pi(params.phoenixImag) {}
+
+		/**
+		 * Takes one iteration of z
+		 *
+		 * @param x  the real component of z (set)
+		 * @param y  the imaginary component of z (set)
+		 * @param ox the real component of the previous z (set)
+		 * @param oy the imaginary component of the previous z (set)
+		 * @param cr the real component of c
+		 * @param ci the imaginary component of c
+		 */
+		inline void step(double& x, double& y, double& ox, double& oy, double cr, double ci) const
+		{
+			double px, py;
+			power.raise(x, y, px, py);
+			px += cr + pr*ox - pi*oy;
+			py += ci + pr*oy + pi*ox;
+			ox = x;
+			oy = y;
+			x  = px;
+			y  = py;
+		}
+	};
+
+	/**
+	 * Computes the batch one point at a time with the iteration function of
+	 * the given Formula (the driver every formula and exponent shares)
+	 *
+	 * @param zr      the real components of the starting points
+	 * @param zi      the imaginary components of the starting points
+	 * @param cr      the real components of the constants
+	 * @param ci      the imaginary components of the constants
+	 * @param count   the number of points in the batch
+	 * @param params  the kernel parameters
+	 * @param out     the number of iterations before infinity of each point
+	 * @param stats   the lane usage of the kernel (added to)
+	 * @param formula the iteration function
+	 */
+	template <typename Count, typename Formula>
+	static void formulaDriver(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats, const Formula& formula)
+	{
+		const double tolerance = params.tolerance * params.tolerance;
+		unsigned long long used = 0;
+		for (unsigned i = 0; i < count; i++)
+		{
+			// Point buffers (the previous z starts at zero)
+			double x = zr[i], y = zi[i], ox = 0, oy = 0;
+			double sx = x, sy = y, dx, dy;
+			unsigned n, save = 1;
+			bool cycle = false;
+
+			// Captured orbits are compared against the fixed capture point (never saving)
+			if (params.capture) { sx = params.captureReal; sy = params.captureImag; save = 0; }
+
+			// Iterative process
+			for (n = 0; n < params.maxIter; n++)
+			{
+				// Iteration function
+				formula.step(x, y, ox, oy, cr[i], ci[i]);
+
+				// Break if z goes to infinity (beyond space, which every
+				// power of at least 2 escapes from as it does for z^2)
+				if (x*x + y*y >= BAILOUT) break;
+
+				// Break if z came back to the saved point (it is cycling)
+				dx = x - sx;
+				dy = y - sy;
+				if (dx*dx + dy*dy < tolerance) { cycle = true; break; }
+
+				// Save z at every power-of-two iteration (Brent)
+				if (n + 1 == save) { sx = x; sy = y; save <<= 1; }
+			}
+
+			// Escaping and cycling points also spend the iteration they stopped on
+			out[i] = cycle ? params.maxIter : n;
+			used  += n < params.maxIter ? n + 1 : n;
+		}
+
+		// One lane is always busy
+		stats.used   += used;
+		stats.issued += used;
+	}
+
+	/**
+	 * Computes the batch with the formula of the kernel parameters raising z
+	 * with the given power
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 * @param power  raises z to the power of d
+	 */
+	template <typename Count, typename Raise>
+	static void powerKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats, const Raise& power)
+	{
+		switch (params.formula)
+		{
+			case BURNING_SHIP_FORMULA:
+				formulaDriver(zr, zi, cr, ci, count, params, out, stats, BurningShipFormula<Raise>(power, params));
+				break;
+			case TRICORN_FORMULA:
+				formulaDriver(zr, zi, cr, ci, count, params, out, stats, TricornFormula<Raise>(power, params));
+				break;
+			case PHOENIX_FORMULA:
+				formulaDriver(zr, zi, cr, ci, count, params, out, stats, PhoenixFormula<Raise>(power, params));
+				break;
+			default:
+				formulaDriver(zr, zi, cr, ci, count, params, out, stats, StandardFormula<Raise>(power, params));
+				break;
+		}
+	}
+
+	/**
+	 * Computes the batch one point at a time with the formula and exponent d
+	 * of the kernel parameters. Whole exponents up to MAX_WHOLE_EXPONENT are
+	 * raised by a multiply chain unrolled for that exponent, and every other
+	 * exponent through the polar form of z. Transcendental formulas are
+	 * iterated with transcendentalKernel.
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void formulaKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		// Transcendental formulas have no exponent
+		if (params.transcendental())
+		{
+			transcendentalKernel(zr, zi, cr, ci, count, params, out, stats);
+			return;
+		}
+
+		// Whole exponents have their own unrolled kernel
+		unsigned degree = (unsigned)params.exponent;
+		if (degree != params.exponent || degree > MAX_WHOLE_EXPONENT)
+			degree = 0;
+
+		switch (degree)
+		{
+			case 2: powerKernel(zr, zi, cr, ci, count, params, out, stats, WholePower<2>()); break;
+			case 3: powerKernel(zr, zi, cr, ci, count, params, out, stats, WholePower<3>()); break;
+			case 4: powerKernel(zr, zi, cr, ci, count, params, out, stats, WholePower<4>()); break;
+			case 5: powerKernel(zr, zi, cr, ci, count, params, out, stats, WholePower<5>()); break;
+			case 6: powerKernel(zr, zi, cr, ci, count, params, out, stats, WholePower<6>()); break;
+			case 7: powerKernel(zr, zi, cr, ci, count, params, out, stats, WholePower<7>()); break;
+			case 8: powerKernel(zr, zi, cr, ci, count, params, out, stats, WholePower<8>()); break;
+			default: powerKernel(zr, zi, cr, ci, count, params, out, stats, PolarPower(params.exponent)); break;
+		}
+	}
+
+	// Kernel for every count width
+	template void formulaKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void formulaKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void formulaKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+}
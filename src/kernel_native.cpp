@@ -0,0 +1,49 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/kernel.h"
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * Computes the batch NATIVE_LANES points at a time with the native build
+	 * of the program of the kernel parameters (which rounds exactly like the
+	 * program kernel, so it renders the same image)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void nativeKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		typename NativeKernel<Count>::Function kernel =
+			reinterpret_cast<typename NativeKernel<Count>::Function>(params.native->function(sizeof(Count)));
+		kernel(zr, zi, cr, ci, count, params.maxIter, params.tolerance * params.tolerance, out, &stats.used, &stats.issued);
+	}
+
+	// Kernel for every count width
+	template void nativeKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void nativeKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void nativeKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+}
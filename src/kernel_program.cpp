@@ -0,0 +1,209 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/kernel.h"
+
+// Libraries being used
+#include <algorithm>
+#include <vector>
+
+// Namespaces being used
+using namespace std;
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * Runs one instruction over every lane (registers are PROGRAM_LANES
+	 * doubles apart, and the written register is never read, so each loop
+	 * is free to vectorise)
+	 *
+	 * @param ins the instruction
+	 * @param re  the real components of the registers
+	 * @param im  the imaginary components of the registers
+	 */
+	static inline void runInstruction(const Instruction& ins, double* re, double* im)
+	{
+		const double* __restrict ar = re + ins.a   * PROGRAM_LANES;
+		const double* __restrict ai = im + ins.a   * PROGRAM_LANES;
+		const double* __restrict br = re + ins.b   * PROGRAM_LANES;
+		const double* __restrict bi = im + ins.b   * PROGRAM_LANES;
+		double* __restrict       dr = re + ins.dst * PROGRAM_LANES;
+		double* __restrict       di = im + ins.dst * PROGRAM_LANES;
+		switch (ins.op)
+		{
+			case ADD_OPCODE:
+				for (unsigned l = 0; l < PROGRAM_LANES; l++) { dr[l] = ar[l] + br[l]; di[l] = ai[l] + bi[l]; }
+				break;
+			case SUB_OPCODE:
+				for (unsigned l = 0; l < PROGRAM_LANES; l++) { dr[l] = ar[l] - br[l]; di[l] = ai[l] - bi[l]; }
+				break;
+			case MUL_OPCODE:
+				for (unsigned l = 0; l < PROGRAM_LANES; l++)
+				{
+					dr[l] = ar[l]*br[l] - ai[l]*bi[l];
+					di[l] = ar[l]*bi[l] + ai[l]*br[l];
+				}
+				break;
+			case DIV_OPCODE:
+				for (unsigned l = 0; l < PROGRAM_LANES; l++)
+				{
+					double d = 1 / (br[l]*br[l] + bi[l]*bi[l]);
+					dr[l] = (ar[l]*br[l] + ai[l]*bi[l]) * d;
+					di[l] = (ai[l]*br[l] - ar[l]*bi[l]) * d;
+				}
+				break;
+			case SQUARE_OPCODE:
+				for (unsigned l = 0; l < PROGRAM_LANES; l++)
+				{
+					dr[l] = ar[l]*ar[l] - ai[l]*ai[l];
+					di[l] = 2*ar[l]*ai[l];
+				}
+				break;
+			case NEG_OPCODE:
+				for (unsigned l = 0; l < PROGRAM_LANES; l++) { dr[l] = -ar[l]; di[l] = -ai[l]; }
+				break;
+			case CONJ_OPCODE:
+				for (unsigned l = 0; l < PROGRAM_LANES; l++) { dr[l] = ar[l]; di[l] = -ai[l]; }
+				break;
+			case REAL_OPCODE:
+				for (unsigned l = 0; l < PROGRAM_LANES; l++) { dr[l] = ar[l]; di[l] = 0; }
+				break;
+			case IMAG_OPCODE:
+				for (unsigned l = 0; l < PROGRAM_LANES; l++) { dr[l] = ai[l]; di[l] = 0; }
+				break;
+		}
+	}
+
+	/**
+	 * Computes the batch PROGRAM_LANES points at a time with the program of
+	 * the kernel parameters. Each iteration runs every instruction over every
+	 * lane, so decoding an instruction costs once per PROGRAM_LANES points,
+	 * and a lane is loaded with the next point as soon as its point escapes,
+	 * cycles or reaches the iteration limit.
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void programKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		// Registers of every lane (dead lanes hold zero, which never overflows)
+		const Program& program = *params.program;
+		vector<double> re(program.registers * PROGRAM_LANES), im(program.registers * PROGRAM_LANES);
+		for (unsigned r = 0; r < program.constants.size(); r++)
+		{
+			fill(&re[(C_REGISTER + 1 + r) * PROGRAM_LANES], &re[(C_REGISTER + 2 + r) * PROGRAM_LANES], program.constants[r].real());
+			fill(&im[(C_REGISTER + 1 + r) * PROGRAM_LANES], &im[(C_REGISTER + 2 + r) * PROGRAM_LANES], program.constants[r].imag());
+		}
+		double* xr = &re[Z_REGISTER * PROGRAM_LANES];
+		double* xi = &im[Z_REGISTER * PROGRAM_LANES];
+		double* kr = &re[C_REGISTER * PROGRAM_LANES];
+		double* ki = &im[C_REGISTER * PROGRAM_LANES];
+		const double* nr = &re[program.result * PROGRAM_LANES];
+		const double* ni = &im[program.result * PROGRAM_LANES];
+
+		// Lane state and the index of the point in each lane
+		const double tolerance = params.tolerance * params.tolerance;
+		double sr[PROGRAM_LANES], si[PROGRAM_LANES];
+		unsigned index[PROGRAM_LANES], n[PROGRAM_LANES];
+		bool live[PROGRAM_LANES];
+		unsigned long long used = 0, issued = 0;
+
+		// Load the first points (lanes without one stay dead)
+		unsigned next = 0, alive = 0;
+		for (unsigned l = 0; l < PROGRAM_LANES; l++)
+		{
+			live[l] = next < count;
+			if (!live[l]) continue;
+			index[l] = next;
+			xr[l] = sr[l] = zr[next];
+			xi[l] = si[l] = zi[next];
+			kr[l] = cr[next];
+			ki[l] = ci[next];
+			n[l]  = 0;
+			next++;
+			alive++;
+		}
+
+		// Iterate until every lane is dead
+		while (alive > 0)
+		{
+			// Run the program over every lane
+			for (vector<Instruction>::const_iterator it = program.code.begin(); it != program.code.end(); ++it)
+				runInstruction(*it, &re[0], &im[0]);
+			issued += PROGRAM_LANES;
+
+			// Check every live lane
+			for (unsigned l = 0; l < PROGRAM_LANES; l++)
+			{
+				// Take the next z
+				xr[l] = nr[l];
+				xi[l] = ni[l];
+				if (!live[l]) continue;
+
+				// Escaped if z went to infinity (beyond space, or not a number)
+				bool escaped = !(xr[l]*xr[l] + xi[l]*xi[l] < BAILOUT);
+				if (!escaped) n[l]++;
+
+				// Cycling if z came back to the saved point
+				double dx = xr[l] - sr[l], dy = xi[l] - si[l];
+				bool cycle = !escaped && dx*dx + dy*dy < tolerance;
+
+				// Save z at every power-of-two iteration (Brent)
+				if (!(n[l] & (n[l] - 1))) { sr[l] = xr[l]; si[l] = xi[l]; }
+				if (!escaped && !cycle && n[l] < params.maxIter) continue;
+
+				// Write back (escaping points also spend the iteration they escaped on)
+				out[index[l]] = cycle ? params.maxIter : n[l];
+				used += escaped ? n[l] + 1 : n[l];
+
+				// Load the next point or kill the lane
+				if (next < count)
+				{
+					index[l] = next;
+					xr[l] = sr[l] = zr[next];
+					xi[l] = si[l] = zi[next];
+					kr[l] = cr[next];
+					ki[l] = ci[next];
+					n[l]  = 0;
+					next++;
+				}
+				else
+				{
+					live[l] = false;
+					xr[l] = xi[l] = kr[l] = ki[l] = 0;
+					alive--;
+				}
+			}
+		}
+
+		stats.used   += used;
+		stats.issued += issued;
+	}
+
+	// Kernel for every count width
+	template void programKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void programKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void programKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+}
@@ -0,0 +1,130 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/kernel.h"
+
+// Libraries being used
+#include <emmintrin.h>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * Computes the batch two points at a time with SSE2
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("sse2")))
+	void sse2Kernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		// Lane buffers (padding lanes start outside the bailout, so they escape at once)
+		double lzr[2], lzi[2], lcr[2], lci[2];
+		long long ln[2], lcycle[2];
+
+		// Constants
+		const __m128d bailout   = _mm_set1_pd(BAILOUT);
+		const __m128d tolerance = _mm_set1_pd(params.tolerance * params.tolerance);
+		const unsigned maxIter  = params.maxIter;
+
+		for (unsigned i = 0; i < count; i += 2)
+		{
+			// Load lanes
+			for (unsigned l = 0; l < 2; l++)
+			{
+				bool pad = i + l >= count;
+				lzr[l] = pad ? SCALE : zr[i + l];
+				lzi[l] = pad ? 0     : zi[i + l];
+				lcr[l] = pad ? SCALE : cr[i + l];
+				lci[l] = pad ? 0     : ci[i + l];
+			}
+			__m128d vzr = _mm_loadu_pd(lzr);
+			__m128d vzi = _mm_loadu_pd(lzi);
+			__m128d vcr = _mm_loadu_pd(lcr);
+			__m128d vci = _mm_loadu_pd(lci);
+
+			// Every lane starts active with zero iterations, saving its starting point
+			__m128d active = _mm_castsi128_pd(_mm_set1_epi32(-1));
+			__m128d cycled = _mm_setzero_pd();
+			__m128i n = _mm_setzero_si128();
+			__m128d vsr = vzr, vsi = vzi;
+			unsigned save = 1;
+
+			// Captured orbits are compared against the fixed capture point (never saving)
+			if (params.capture)
+			{
+				vsr  = _mm_set1_pd(params.captureReal);
+				vsi  = _mm_set1_pd(params.captureImag);
+				save = 0;
+			}
+
+			// Iterative process
+			unsigned k;
+			for (k = 0; k < maxIter; k++)
+			{
+				// Iteration function (z = z^2 + c)
+				__m128d zi2 = _mm_mul_pd(vzi, vzi);
+				__m128d nzi = _mm_add_pd(_mm_mul_pd(_mm_add_pd(vzr, vzr), vzi), vci);
+				vzr = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(vzr, vzr), zi2), vcr);
+				vzi = nzi;
+
+				// Mask off lanes that went to infinity (beyond space)
+				__m128d mag = _mm_add_pd(_mm_mul_pd(vzr, vzr), _mm_mul_pd(vzi, vzi));
+				active = _mm_and_pd(active, _mm_cmplt_pd(mag, bailout));
+
+				// Mask off lanes that came back to their saved point (they are cycling)
+				__m128d dr = _mm_sub_pd(vzr, vsr), di = _mm_sub_pd(vzi, vsi);
+				__m128d cycle = _mm_and_pd(active, _mm_cmplt_pd(_mm_add_pd(_mm_mul_pd(dr, dr), _mm_mul_pd(di, di)), tolerance));
+				cycled = _mm_or_pd(cycled, cycle);
+				active = _mm_andnot_pd(cycle, active);
+
+				// Count an iteration for every lane still active (mask is -1)
+				n = _mm_sub_epi64(n, _mm_castpd_si128(active));
+
+				// Break when every lane is done
+				if (!_mm_movemask_pd(active)) break;
+
+				// Save z at every power-of-two iteration (Brent)
+				if (k + 1 == save) { vsr = vzr; vsi = vzi; save <<= 1; }
+			}
+
+			// Every lane is issued until the slowest lane is done
+			stats.issued += 2 * (k < maxIter ? k + 1 : k);
+
+			// Store iterations (escaping and cycling lanes also spent the iteration they stopped on)
+			_mm_storeu_si128((__m128i*)ln, n);
+			_mm_storeu_si128((__m128i*)lcycle, _mm_castpd_si128(cycled));
+			for (unsigned l = 0; l < 2 && i + l < count; l++)
+			{
+				out[i + l]  = lcycle[l] ? maxIter : ln[l];
+				stats.used += ln[l] < maxIter ? ln[l] + 1 : ln[l];
+			}
+		}
+	}
+
+	// Kernels for every count width
+	template void sse2Kernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void sse2Kernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void sse2Kernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+}
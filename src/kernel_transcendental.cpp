@@ -0,0 +1,430 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/kernel.h"
+#include "Fractal/vmath.h"
+
+// Libraries being used
+#include <cmath>
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * The iteration function z = c e^z, which escapes to infinity once Re z
+	 * passes TRANSCENDENTAL_BAILOUT
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct ExpFamily
+	{
+		/**
+		 * Takes one iteration of z
+		 *
+		 * @param x  the real component of z (set)
+		 * @param y  the imaginary component of z (set)
+		 * @param cr the real component of c
+		 * @param ci the imaginary component of c
+		 */
+		inline void step(double& x, double& y, double cr, double ci) const
+		{
+			double e = std::exp(x), fr = e * std::cos(y), fi = e * std::sin(y);
+			x = cr*fr - ci*fi;
+			y = cr*fi + ci*fr;
+		}
+
+		/**
+		 * Returns true if z has gone to infinity
+		 *
+		 * @param x the real component of z
+		 * @param y the imaginary component of z
+		 *
+		 * @return true if z has gone to infinity (or is not a number)
+		 */
+		inline bool escaped(double x, double y) const
+		{
+			return !(x < TRANSCENDENTAL_BAILOUT);
+		}
+
+		/**
+		 * Takes one iteration of z in every lane
+		 *
+		 * @param x  the real components of z (set)
+		 * @param y  the imaginary components of z (set)
+		 * @param cr the real components of c
+		 * @param ci the imaginary components of c
+		 */
+		__attribute__((target("avx2,fma")))
+		inline void step(__m256d& x, __m256d& y, __m256d cr, __m256d ci) const
+		{
+			__m256d fr, fi;
+			vcexp(x, y, fr, fi);
+			x = _mm256_fmsub_pd(cr, fr, _mm256_mul_pd(ci, fi));
+			y = _mm256_fmadd_pd(cr, fi, _mm256_mul_pd(ci, fr));
+		}
+
+		/**
+		 * Returns the lanes in which z has not gone to infinity
+		 *
+		 * @param x the real components of z
+		 * @param y the imaginary components of z
+		 *
+		 * @return a mask of the lanes still bounded
+		 */
+		__attribute__((target("avx2,fma")))
+		inline __m256d bounded(__m256d x, __m256d y) const
+		{
+			return _mm256_cmp_pd(x, _mm256_set1_pd(TRANSCENDENTAL_BAILOUT), _CMP_LT_OQ);
+		}
+	};
+
+	/**
+	 * The iteration function z = c sin z, which escapes to infinity once
+	 * |Im z| passes TRANSCENDENTAL_BAILOUT
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct SineFamily
+	{
+		/**
+		 * Takes one iteration of z
+		 *
+		 * @param x  the real component of z (set)
+		 * @param y  the imaginary component of z (set)
+		 * @param cr the real component of c
+		 * @param ci the imaginary component of c
+		 */
+		inline void step(double& x, double& y, double cr, double ci) const
+		{
+			double fr = std::sin(x) * std::cosh(y), fi = std::cos(x) * std::sinh(y);
+			x = cr*fr - ci*fi;
+			y = cr*fi + ci*fr;
+		}
+
+		/**
+		 * Returns true if z has gone to infinity
+		 *
+		 * @param x the real component of z
+		 * @param y the imaginary component of z
+		 *
+		 * @return true if z has gone to infinity (or is not a number)
+		 */
+		inline bool escaped(double x, double y) const
+		{
+			return !(std::fabs(y) < TRANSCENDENTAL_BAILOUT) || x != x;
+		}
+
+		/**
+		 * Takes one iteration of z in every lane
+		 *
+		 * @param x  the real components of z (set)
+		 * @param y  the imaginary components of z (set)
+		 * @param cr the real components of c
+		 * @param ci the imaginary components of c
+		 */
+		__attribute__((target("avx2,fma")))
+		inline void step(__m256d& x, __m256d& y, __m256d cr, __m256d ci) const
+		{
+			__m256d fr, fi;
+			vcsin(x, y, fr, fi);
+			x = _mm256_fmsub_pd(cr, fr, _mm256_mul_pd(ci, fi));
+			y = _mm256_fmadd_pd(cr, fi, _mm256_mul_pd(ci, fr));
+		}
+
+		/**
+		 * Returns the lanes in which z has not gone to infinity
+		 *
+		 * @param x the real components of z
+		 * @param y the imaginary components of z
+		 *
+		 * @return a mask of the lanes still bounded
+		 */
+		__attribute__((target("avx2,fma")))
+		inline __m256d bounded(__m256d x, __m256d y) const
+		{
+			__m256d ay = _mm256_andnot_pd(_mm256_set1_pd(-0.0), y);
+			return _mm256_and_pd(_mm256_cmp_pd(ay, _mm256_set1_pd(TRANSCENDENTAL_BAILOUT), _CMP_LT_OQ),
+				_mm256_cmp_pd(x, x, _CMP_ORD_Q));
+		}
+	};
+
+	/**
+	 * The iteration function z = c cos z, which escapes to infinity once
+	 * |Im z| passes TRANSCENDENTAL_BAILOUT
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct CosineFamily : public SineFamily
+	{
+		/**
+		 * Takes one iteration of z
+		 *
+		 * @param x  the real component of z (set)
+		 * @param y  the imaginary component of z (set)
+		 * @param cr the real component of c
+		 * @param ci the imaginary component of c
+		 */
+		inline void step(double& x, double& y, double cr, double ci) const
+		{
+			double fr = std::cos(x) * std::cosh(y), fi = -std::sin(x) * std::sinh(y);
+			x = cr*fr - ci*fi;
+			y = cr*fi + ci*fr;
+		}
+
+		/**
+		 * Takes one iteration of z in every lane
+		 *
+		 * @param x  the real components of z (set)
+		 * @param y  the imaginary components of z (set)
+		 * @param cr the real components of c
+		 * @param ci the imaginary components of c
+		 */
+		__attribute__((target("avx2,fma")))
+		inline void step(__m256d& x, __m256d& y, __m256d cr, __m256d ci) const
+		{
+			__m256d fr, fi;
+			vccos(x, y, fr, fi);
+			x = _mm256_fmsub_pd(cr, fr, _mm256_mul_pd(ci, fi));
+			y = _mm256_fmadd_pd(cr, fi, _mm256_mul_pd(ci, fr));
+		}
+	};
+
+	/**
+	 * Computes the batch one point at a time with the given transcendental
+	 * iteration function (using libm)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 * @param family the iteration function
+	 */
+	template <typename Count, typename Family>
+	static void transcendentalDriver(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats, const Family& family)
+	{
+		const double tolerance = params.tolerance * params.tolerance;
+		unsigned long long used = 0;
+		for (unsigned i = 0; i < count; i++)
+		{
+			// Point buffers
+			double x = zr[i], y = zi[i];
+			double sx = x, sy = y, dx, dy;
+			unsigned n, save = 1;
+			bool cycle = false;
+
+			// Iterative process
+			for (n = 0; n < params.maxIter; n++)
+			{
+				// Iteration function
+				family.step(x, y, cr[i], ci[i]);
+
+				// Break if z goes to infinity
+				if (family.escaped(x, y)) break;
+
+				// Break if z came back to the saved point (it is cycling)
+				dx = x - sx;
+				dy = y - sy;
+				if (dx*dx + dy*dy < tolerance) { cycle = true; break; }
+
+				// Save z at every power-of-two iteration (Brent)
+				if (n + 1 == save) { sx = x; sy = y; save <<= 1; }
+			}
+
+			// Escaping and cycling points also spend the iteration they stopped on
+			out[i] = cycle ? params.maxIter : n;
+			used  += n < params.maxIter ? n + 1 : n;
+		}
+
+		// One lane is always busy
+		stats.used   += used;
+		stats.issued += used;
+	}
+
+	/**
+	 * Computes the batch four points at a time with AVX2 and FMA with the
+	 * given transcendental iteration function (using vmath)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 * @param family the iteration function
+	 */
+	template <typename Count, typename Family>
+	__attribute__((target("avx2,fma")))
+	static void avx2TranscendentalDriver(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats, const Family& family)
+	{
+		// Lane buffers (padding lanes start at zero with c zero, and are masked off)
+		double lzr[4], lzi[4], lcr[4], lci[4];
+		long long ln[4], lcycle[4], lpad[4];
+
+		// Constants
+		const __m256d tolerance = _mm256_set1_pd(params.tolerance * params.tolerance);
+		const unsigned maxIter  = params.maxIter;
+
+		for (unsigned i = 0; i < count; i += 4)
+		{
+			// Load lanes
+			for (unsigned l = 0; l < 4; l++)
+			{
+				bool pad = i + l >= count;
+				lzr[l]  = pad ? 0 : zr[i + l];
+				lzi[l]  = pad ? 0 : zi[i + l];
+				lcr[l]  = pad ? 0 : cr[i + l];
+				lci[l]  = pad ? 0 : ci[i + l];
+				lpad[l] = pad ? 0 : -1;
+			}
+			__m256d vzr = _mm256_loadu_pd(lzr);
+			__m256d vzi = _mm256_loadu_pd(lzi);
+			__m256d vcr = _mm256_loadu_pd(lcr);
+			__m256d vci = _mm256_loadu_pd(lci);
+
+			// Every real lane starts active with zero iterations, saving its starting point
+			__m256d active = _mm256_castsi256_pd(_mm256_loadu_si256((const __m256i*)lpad));
+			__m256d cycled = _mm256_setzero_pd();
+			__m256i n = _mm256_setzero_si256();
+			__m256d vsr = vzr, vsi = vzi;
+			unsigned save = 1;
+
+			// Iterative process
+			unsigned k;
+			for (k = 0; k < maxIter; k++)
+			{
+				// Iteration function
+				family.step(vzr, vzi, vcr, vci);
+
+				// Mask off lanes that went to infinity
+				active = _mm256_and_pd(active, family.bounded(vzr, vzi));
+
+				// Mask off lanes that came back to their saved point (they are cycling)
+				__m256d dr = _mm256_sub_pd(vzr, vsr), di = _mm256_sub_pd(vzi, vsi);
+				__m256d dist = _mm256_fmadd_pd(dr, dr, _mm256_mul_pd(di, di));
+				__m256d cycle = _mm256_and_pd(active, _mm256_cmp_pd(dist, tolerance, _CMP_LT_OQ));
+				cycled = _mm256_or_pd(cycled, cycle);
+				active = _mm256_andnot_pd(cycle, active);
+
+				// Count an iteration for every lane still active (mask is -1)
+				n = _mm256_sub_epi64(n, _mm256_castpd_si256(active));
+
+				// Break when every lane is done
+				if (_mm256_testz_pd(active, active)) break;
+
+				// Save z at every power-of-two iteration (Brent)
+				if (k + 1 == save) { vsr = vzr; vsi = vzi; save <<= 1; }
+			}
+
+			// Every lane is issued until the slowest lane is done
+			stats.issued += 4 * (k < maxIter ? k + 1 : k);
+
+			// Store iterations (escaping and cycling lanes also spent the iteration they stopped on)
+			_mm256_storeu_si256((__m256i*)ln, n);
+			_mm256_storeu_si256((__m256i*)lcycle, _mm256_castpd_si256(cycled));
+			for (unsigned l = 0; l < 4 && i + l < count; l++)
+			{
+				out[i + l]  = lcycle[l] ? maxIter : ln[l];
+				stats.used += ln[l] < maxIter ? ln[l] + 1 : ln[l];
+			}
+		}
+	}
+
+	/**
+	 * Computes the batch one point at a time with the transcendental formula
+	 * of the kernel parameters (using libm)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	void transcendentalKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		switch (params.formula)
+		{
+			case EXP_FORMULA:
+				transcendentalDriver(zr, zi, cr, ci, count, params, out, stats, ExpFamily());
+				break;
+			case SINE_FORMULA:
+				transcendentalDriver(zr, zi, cr, ci, count, params, out, stats, SineFamily());
+				break;
+			default:
+				transcendentalDriver(zr, zi, cr, ci, count, params, out, stats, CosineFamily());
+				break;
+		}
+	}
+
+	/**
+	 * Computes the batch four points at a time with AVX2 and FMA with the
+	 * transcendental formula of the kernel parameters (using vmath)
+	 *
+	 * @param zr     the real components of the starting points
+	 * @param zi     the imaginary components of the starting points
+	 * @param cr     the real components of the constants
+	 * @param ci     the imaginary components of the constants
+	 * @param count  the number of points in the batch
+	 * @param params the kernel parameters
+	 * @param out    the number of iterations before infinity of each point
+	 * @param stats  the lane usage of the kernel (added to)
+	 */
+	template <typename Count>
+	__attribute__((target("avx2,fma")))
+	void avx2TranscendentalKernel(const double* zr, const double* zi,
+		const double* cr, const double* ci, unsigned count,
+		const KernelParams& params, Count* out, KernelStats& stats)
+	{
+		switch (params.formula)
+		{
+			case EXP_FORMULA:
+				avx2TranscendentalDriver(zr, zi, cr, ci, count, params, out, stats, ExpFamily());
+				break;
+			case SINE_FORMULA:
+				avx2TranscendentalDriver(zr, zi, cr, ci, count, params, out, stats, SineFamily());
+				break;
+			default:
+				avx2TranscendentalDriver(zr, zi, cr, ci, count, params, out, stats, CosineFamily());
+				break;
+		}
+	}
+
+	// Kernels for every count width
+	template void transcendentalKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void transcendentalKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void transcendentalKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+
+	template void avx2TranscendentalKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned char*,  KernelStats&);
+	template void avx2TranscendentalKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned short*, KernelStats&);
+	template void avx2TranscendentalKernel(const double*, const double*, const double*, const double*, unsigned, const KernelParams&, unsigned*,       KernelStats&);
+}
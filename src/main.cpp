@@ -12,13 +12,18 @@
 #include "Fractal/fractal.h"
 #include "Fractal/colormaps.h"
 #include "Fractal/error.h"
+#include "Fractal/interior.h"
+#include "Fractal/kernel.h"
+#include "Fractal/threadpool.h"
 
 // Libraries being used
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <vector>
 #include <cstdlib>
 #include <cstring>
-#include <ctime>
+#include <sys/time.h>
 
 // Namespaces being used
 using namespace std;
@@ -27,6 +32,13 @@ using namespace pugi;
 using namespace fractal;
 using namespace fractal::colormap;
 
+/**
+ * Returns the current wall clock time in seconds
+ *
+ * @return the current wall clock time in seconds
+ */
+double wallTime();
+
 /**
  * Shows a list of the available colormaps
  */
@@ -54,7 +66,7 @@ void testCmap(string sname, ColorMapRGB* cmap);
  *
  * @return the number of iterations performed
  */
-int generate(string sname, Transform trans,
+unsigned long long generate(string sname, Transform trans,
 	ColorMapRGB* cmap, bool mbrot,
 	complex<double> cons);
 
@@ -63,8 +75,45 @@ int generate(string sname, Transform trans,
  *
  * @param docname the name of the document to parse
  * @param id      the id of the fractal to generate (all if empty)
+ * @param maxIter the iteration limit of fractals without one (0 for auto)
+ * @param power   the exponent of fractals without one
+ * @param fname   the formula of fractals without one
+ * @param phoenix the Phoenix constant p of fractals without one
+ * @param custom  the custom formula of fractals without one (none if empty)
+ */
+void runXML(string docname, string id, unsigned maxIter, double power, string fname, complex<double> phoenix, string custom) throw(Error);
+
+/**
+ * Parses the given iteration limit ("auto" returns 0)
+ *
+ * @param limit the iteration limit to parse
+ *
+ * @return the iteration limit (0 for auto)
+ *
+ * @throw Error when limit is neither "auto" nor a positive number
+ */
+unsigned parseMaxIter(string limit) throw(Error);
+
+/**
+ * Returns the precisions the tiles of the image were rendered in (such as
+ * "float and double"), or the given precision if none were tiled
+ *
+ * @param stats     the stats of the image
+ * @param precision the precision of the image
+ *
+ * @return the precisions the image was rendered in
+ */
+string precisionList(const KernelStats& stats, Precision precision);
+
+/**
+ * Returns the number of tiles rendered in each precision (such as
+ * "12 float, 58 double tiles"), which is empty if none were tiled
+ *
+ * @param stats the stats of the image
+ *
+ * @return the number of tiles rendered in each precision
  */
-void runXML(string docname, string id) throw(Error);
+string tileList(const KernelStats& stats);
 
 /**
  * The main function of the program
@@ -90,11 +139,30 @@ int main(int argc, char const *argv[])
 	unsigned imgx   = cimg_option("-imgx",  1920, 		  "The image width");
 	unsigned imgy   = cimg_option("-imgy",  1080, 		  "The image height");
 	double zoom     = cimg_option("-zoom",  1.0,  		  "The zoom scale of the image");
-	double offx     = cimg_option("-offx",  0.0,  		  "The x offset of the image");
-	double offy     = cimg_option("-offy",  0.0,  		  "The y offset of the image");
+	string offx     = cimg_option("-offx",  "0",  		  "The x offset of the image (every digit is kept)");
+	string offy     = cimg_option("-offy",  "0",  		  "The y offset of the image (every digit is kept)");
 	double rot      = cimg_option("-rot",   0.0,  		  "The angle of rotation of the image (in degrees)");
 	string sname    = cimg_option("-save",  "jimage.jpg", "The file to save the image to");
 	string cname    = cimg_option("-cmap",  "rainbow",    "The colormapping to use");
+	unsigned threads = cimg_option("-threads", 0,          "The number of render threads (all cores if 0)");
+	string kname    = cimg_option("-kernel", "auto",      "The escape-time kernel to render with (auto, scalar, sse2, avx2, avx512, avx2-refill, avx512-refill, reference)");
+	string mname    = cimg_option("-mode",   "brute-force", "How the pixels of each tile are picked for iterating (brute-force, subdivide, trace)");
+	bool verify     = cimg_option("-verify", false,       "Also renders with the reference kernel and reports pixel mismatches");
+	bool bulbs      = cimg_option("-bulbs",  false,       "Also skips mandelbrot pixels inside a table of smaller bulbs");
+	bool symmetric  = cimg_option("-symmetry", true,      "Copies pixels mirrored under the symmetry of the set instead of iterating them (off to disable)");
+	bool period     = cimg_option("-period", true,        "Stops orbits that settle into a cycle early (off to disable)");
+	bool capture    = cimg_option("-capture", true,       "Stops julia set orbits once they are drawn into the attracting cycle of c (off to disable)");
+	string limit    = cimg_option("-maxiter", "256",      "The iteration limit (auto picks it from the zoom)");
+	double power    = cimg_option("-exponent", 2.0,       "The exponent d of the iteration function z = z^d + c (at least 2)");
+	string fname    = cimg_option("-formula", "standard", "The iteration function (standard, burning-ship, tricorn, phoenix, exp, sin, cos)");
+	double preal    = cimg_option("-pr",    -0.5,         "The real component of the phoenix constant p");
+	double pimag    = cimg_option("-pi",    0.0,          "The imaginary component of the phoenix constant p");
+	string custom   = cimg_option("-custom", "",          "A custom iteration function of z and c, such as z*z*z + c*z + 0.3 (overrides -formula and -exponent)");
+	bool jit        = cimg_option("-jit",   false,        "Builds custom iteration functions into native code with g++ (falls back to bytecode if it can not)");
+	string cache    = cimg_option("-jitcache", "",        "The directory native builds are cached in (~/.cache/fractal if empty)");
+	string pname    = cimg_option("-precision", "auto",   "The number type points are iterated in (float, double, double-double, fixed, perturbation, auto)");
+	bool series     = cimg_option("-series", true,        "Skips the first iterations of perturbed pixels with a series approximation (off to disable)");
+	bool bla        = cimg_option("-bla",    true,        "Lets perturbed pixels take many iterations at once with bilinear steps (off to disable)");
 	bool showcmaps  = cimg_option("-cmaps", false,		  "Lists the cmaps");
 	bool testcmap   = cimg_option("-test",  false,        "Generates a 400x300 test image (saved to the sname) for the set colormap");
 	bool help       = cimg_option("-help",  false,        "Prints the help message")
@@ -105,6 +173,25 @@ int main(int argc, char const *argv[])
 		// Initialize presets
 		initPresets();
 
+		// Initialize render threads and kernel
+		initThreadPool(threads);
+		selectKernel(kname);
+		selectRenderMode(mname);
+		setSymmetry(symmetric);
+		setVerify(verify);
+		setInteriorTable(bulbs);
+		setPeriodicity(period);
+		setCapture(capture);
+		setMaxIter(parseMaxIter(limit));
+		setExponent(power);
+		selectFormula(fname);
+		setPhoenix(complex<double>(preal, pimag));
+		setNative(jit, cache);
+		setProgram(custom);
+		selectPrecision(pname);
+		setSeriesApproximation(series);
+		setBilinearApproximation(bla);
+
 		// Functions
 		if (help)
 			// If they just wanted help
@@ -117,7 +204,7 @@ int main(int argc, char const *argv[])
 			testCmap(sname, getPreset(cname));
 		else if (!xml.empty())
 			// Parse XML document
-			runXML(xml, id);
+			runXML(xml, id, parseMaxIter(limit), power, fname, complex<double>(preal, pimag), custom);
 		else
 			// Command line interface
 			generate(sname, Transform(ImgSize(imgx, imgy),zoom,offx,offy,rot),
@@ -139,8 +226,13 @@ int main(int argc, char const *argv[])
  *
  * @param docname the name of the document to parse
  * @param id      the id of the fractal to generate (all if empty)
+ * @param maxIter the iteration limit of fractals without one (0 for auto)
+ * @param power   the exponent of fractals without one
+ * @param fname   the formula of fractals without one
+ * @param phoenix the Phoenix constant p of fractals without one
+ * @param custom  the custom formula of fractals without one (none if empty)
  */
-void runXML(string docname, string id) throw(Error)
+void runXML(string docname, string id, unsigned maxIter, double power, string fname, complex<double> phoenix, string custom) throw(Error)
 {
 	// Read xml doc (error if read fails)
 	xml_document jdoc;
@@ -157,10 +249,10 @@ void runXML(string docname, string id) throw(Error)
 	complex<double> cons(0,0);
 
 	// Start clock
-	double time = clock();
+	double time = wallTime();
 
 	// Number of iterations
-	unsigned iter = 0;
+	unsigned long long iter = 0;
 
 	// For each fractal object
 	for (xml_node fractal = jdoc.child("fractal"); fractal; fractal = fractal.next_sibling("fractal"))
@@ -173,6 +265,11 @@ void runXML(string docname, string id) throw(Error)
 		cmap  = parseColorMap(fractal.child("colormap"));
 		mbrot = fractal.attribute("mbrot").as_bool();
 		cons  = rectFromXML(fractal.child("complex"));
+		setMaxIter(fractal.attribute("maxiter") ? parseMaxIter(fractal.attribute("maxiter").as_string()) : maxIter);
+		setExponent(fractal.attribute("exponent").as_double(power));
+		selectFormula(fractal.attribute("formula").as_string(fname.c_str()));
+		setPhoenix(fractal.child("phoenix") ? rectFromXML(fractal.child("phoenix")) : phoenix);
+		setProgram(fractal.child("formula") ? fractal.child_value("formula") : custom);
 
 		// Generate image (if needed)
 		if (id.empty() || fid == id)
@@ -180,13 +277,87 @@ void runXML(string docname, string id) throw(Error)
 	}
 
 	// End clock
-	time = (clock() - time) / CLOCKS_PER_SEC;
+	time = wallTime() - time;
 
 	// Print end information
 	cout << "Total Iterations: " << iter << endl;
 	cout << "Total Time:       " << time << " seconds" << endl;
 }
 
+/**
+ * Parses the given iteration limit ("auto" returns 0)
+ *
+ * @param limit the iteration limit to parse
+ *
+ * @return the iteration limit (0 for auto)
+ *
+ * @throw Error when limit is neither "auto" nor a positive number
+ */
+unsigned parseMaxIter(string limit) throw(Error)
+{
+	// Auto picks the limit from the zoom
+	if (limit == "auto") return 0;
+
+	// Error if not a positive number
+	char* end;
+	unsigned long value = strtoul(limit.c_str(), &end, 10);
+	if (limit.empty() || *end || value == 0 || value > 0xFFFFFFFFul)
+		throw Error("Invalid iteration limit: " + limit + ". Expected a positive number or auto.");
+	return value;
+}
+
+/**
+ * Returns the number of tiles rendered in each precision (such as
+ * "12 float, 58 double tiles"), which is empty if none were tiled
+ *
+ * @param stats the stats of the image
+ *
+ * @return the number of tiles rendered in each precision
+ */
+string tileList(const KernelStats& stats)
+{
+	ostringstream list;
+	for (unsigned i = 0; i < PRECISION_COUNT; i++)
+		if (stats.tiles[i])
+			list << (list.tellp() > 0 ? ", " : "") << stats.tiles[i] << " " << getPrecisionName((Precision)i);
+	if (list.tellp() > 0) list << " tiles";
+	return list.str();
+}
+
+/**
+ * Returns the precisions the tiles of the image were rendered in (such as
+ * "float and double"), or the given precision if none were tiled
+ *
+ * @param stats     the stats of the image
+ * @param precision the precision of the image
+ *
+ * @return the precisions the image was rendered in
+ */
+string precisionList(const KernelStats& stats, Precision precision)
+{
+	vector<string> names;
+	for (unsigned i = 0; i < PRECISION_COUNT; i++)
+		if (stats.tiles[i]) names.push_back(getPrecisionName((Precision)i));
+	if (names.empty()) return getPrecisionName(precision);
+
+	string list = names[0];
+	for (unsigned i = 1; i < names.size(); i++)
+		list += (i + 1 < names.size() ? ", " : " and ") + names[i];
+	return list;
+}
+
+/**
+ * Returns the current wall clock time in seconds
+ *
+ * @return the current wall clock time in seconds
+ */
+double wallTime()
+{
+	timeval now;
+	gettimeofday(&now, 0);
+	return now.tv_sec + now.tv_usec / 1e6;
+}
+
 /**
  * Shows a list of the available colormaps
  */
@@ -220,7 +391,7 @@ void testCmap(string sname, ColorMapRGB* cmap)
 	cimg_forXY(image, x, y)
 	{
 		// Get color
-		color = cmap->color(256 * x / image.width());
+		color = cmap->color(MAX_ITER * x / image.width(), MAX_ITER);
 
 		// Set color
 		image(x, y, 0) = color.red;
@@ -243,7 +414,7 @@ void testCmap(string sname, ColorMapRGB* cmap)
  *
  * @return the number of iterations performed
  */
-int generate(string sname, Transform trans, ColorMapRGB* cmap, bool mbrot, complex<double> cons)
+unsigned long long generate(string sname, Transform trans, ColorMapRGB* cmap, bool mbrot, complex<double> cons)
 {
 	// Image (with 3 color channels)
 	CImg<char> jimage(trans.size.width, trans.size.height, 1, 3);
@@ -253,18 +424,19 @@ int generate(string sname, Transform trans, ColorMapRGB* cmap, bool mbrot, compl
 	// Print dimensions
 	cout << "Generating " << sname << "..." << endl;
 
-	// Iterations
-	unsigned iter;
+	// Iterations and kernel lane usage
+	unsigned long long iter;
+	KernelStats stats;
 
 	// Start clock
-	double time = clock();
+	double time = wallTime();
 
 	// Generate either mandelbrot or juliaset image
-	iter = mbrot ? generateMandelbrotSetImage(jimage, trans, cmap)
-				 : generateJuliaSetImage(jimage, cons, trans, cmap);
+	iter = mbrot ? generateMandelbrotSetImage(jimage, trans, cmap, &stats)
+				 : generateJuliaSetImage(jimage, cons, trans, cmap, &stats);
 
 	// End clock
-	time = (clock() - time) / CLOCKS_PER_SEC;
+	time = wallTime() - time;
 
 	// --------------------------SAVE AND RETURN--------------------------
 
@@ -274,6 +446,44 @@ int generate(string sname, Transform trans, ColorMapRGB* cmap, bool mbrot, compl
 	// Print end information
 	cout << "	Iterations: " << iter << endl;
 	cout << "	Time:       " << time << " seconds" << endl;
+	cout << "	Max iter:   " << maxIterations(trans) << endl;
+	if (kernelParams(trans).program)
+	{
+		cout << "	Formula:    " << kernelParams(trans).program->source;
+		if (kernelParams(trans).native)
+			cout << " (native)" << endl;
+		else
+			cout << " (" << kernelParams(trans).program->code.size() << " instructions"
+				 << (getNativeError().empty() ? "" : ", native build failed: " + getNativeError()) << ")" << endl;
+	}
+	else if (kernelParams(trans).formula != STANDARD_FORMULA)
+		cout << "	Formula:    " << getFormulaName(kernelParams(trans).formula) << endl;
+	if (kernelParams(trans).exponent != 2 && !kernelParams(trans).program && !kernelParams(trans).transcendental())
+		cout << "	Exponent:   " << kernelParams(trans).exponent << endl;
+	cout << "	Kernel:     " << getKernelName() << endl;
+	cout << "	Precision:  " << precisionList(stats, kernelParams(trans).precision);
+	if (kernelParams(trans).automatic)
+		cout << " (auto" << (tileList(stats).empty() ? "" : ": " + tileList(stats)) << ")";
+	else if (kernelParams(trans).precision == FLOAT_PRECISION && stats.tiles[DOUBLE_PRECISION])
+		cout << " (" << tileList(stats) << ")";
+	cout << endl;
+	cout << "	Lane usage: " << 100 * stats.utilisation() << "%" << endl;
+	if (getRenderMode() != BRUTE_FORCE_MODE)
+		cout << "	Mode:       " << getRenderModeName(getRenderMode()) << " (" << stats.iterated << " of "
+			 << jimage.width() * jimage.height() << " pixels iterated)" << endl;
+	if (stats.references)
+		cout << "	References: " << stats.references << " (" << stats.reused << " reused, "
+			 << stats.glitched << " pixels left glitched)" << endl;
+	if (stats.skipped)
+		cout << "	Skipped:    " << stats.skipped << " iterations" << endl;
+	if (stats.mirrored)
+		cout << "	Mirrored:   " << stats.mirrored << " pixels" << endl;
+	if (stats.checked)
+		cout << "	Mismatches: " << stats.mismatched << " of " << stats.checked
+			 << " pixels (at most " << stats.maxDifference << " iterations apart)" << endl;
+	if (stats.compared)
+		cout << "	Misfilled:  " << stats.misfilled << " of " << stats.compared
+			 << " pixels (against " << getRenderModeName(BRUTE_FORCE_MODE) << ")" << endl;
 
 	// Return iterations
 	return iter;
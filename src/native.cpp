@@ -0,0 +1,445 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/native.h"
+#include "Fractal/kernel.h"
+
+// Libraries being used
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Namespaces being used
+using namespace std;
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	// Names of the native kernels (in the order of their count widths)
+	static const char* nativeNames[] = { "native_u8", "native_u16", "native_u32" };
+
+	// Count types of the native kernels (in the order of their count widths)
+	static const char* nativeTypes[] = { "unsigned char", "unsigned short", "unsigned" };
+
+	/**
+	 * Returns the given double as an exact C++ literal
+	 *
+	 * @param x the double
+	 *
+	 * @return the double as an exact C++ literal
+	 */
+	static string literal(double x)
+	{
+		if (x != x)   return "__builtin_nan(\"\")";
+		if (x >  DBL_MAX) return "__builtin_inf()";
+		if (x < -DBL_MAX) return "-__builtin_inf()";
+		char buffer[64];
+		snprintf(buffer, sizeof(buffer), "%a", x);
+		return buffer;
+	}
+
+	/**
+	 * Returns the name of the given component of the given register (z and
+	 * c are held in arrays of every lane, and read at lane l)
+	 *
+	 * @param r    the register
+	 * @param part 'r' for the real component, 'i' for the imaginary component
+	 *
+	 * @return the name of the component of the register
+	 */
+	static string reg(unsigned r, char part)
+	{
+		ostringstream str;
+		str << "r" << r << part;
+		if (r <= C_REGISTER) str << "[l]";
+		return str.str();
+	}
+
+	/**
+	 * Returns the C++ statement declaring the result of the given instruction
+	 * (rounded exactly like the program kernel rounds it)
+	 *
+	 * @param ins the instruction
+	 *
+	 * @return the C++ statement running the instruction
+	 */
+	static string statement(const Instruction& ins)
+	{
+		string ar = reg(ins.a, 'r'), ai = reg(ins.a, 'i');
+		string br = reg(ins.b, 'r'), bi = reg(ins.b, 'i');
+		string re, im;
+		switch (ins.op)
+		{
+			case ADD_OPCODE:    re = ar + " + " + br;                     im = ai + " + " + bi;                     break;
+			case SUB_OPCODE:    re = ar + " - " + br;                     im = ai + " - " + bi;                     break;
+			case MUL_OPCODE:    re = ar + "*" + br + " - " + ai + "*" + bi; im = ar + "*" + bi + " + " + ai + "*" + br; break;
+			case DIV_OPCODE:
+				re = "(" + ar + "*" + br + " + " + ai + "*" + bi + ") * (1 / (" + br + "*" + br + " + " + bi + "*" + bi + "))";
+				im = "(" + ai + "*" + br + " - " + ar + "*" + bi + ") * (1 / (" + br + "*" + br + " + " + bi + "*" + bi + "))";
+				break;
+			case SQUARE_OPCODE: re = ar + "*" + ar + " - " + ai + "*" + ai; im = "2*" + ar + "*" + ai;                  break;
+			case NEG_OPCODE:    re = "-" + ar;                            im = "-" + ai;                            break;
+			case CONJ_OPCODE:   re = ar;                                  im = "-" + ai;                            break;
+			case REAL_OPCODE:   re = ar;                                  im = "0";                                 break;
+			case IMAG_OPCODE:   re = ai;                                  im = "0";                                 break;
+		}
+		return "const double " + reg(ins.dst, 'r') + " = " + re + ", " + reg(ins.dst, 'i') + " = " + im + ";";
+	}
+
+	/**
+	 * Returns the C++ source of the native kernels of the given program
+	 *
+	 * @param program the program
+	 *
+	 * @return the C++ source of the native kernels of the program
+	 */
+	string nativeSource(const Program& program)
+	{
+		// The formula (on one line, as it is a comment)
+		string formula = program.source;
+		for (unsigned i = 0; i < formula.size(); i++)
+			if (formula[i] == '\n' || formula[i] == '\r') formula[i] = ' ';
+
+		ostringstream src;
+		src << "// Native kernels of z = " << formula << "\n\n";
+
+		// Constant registers
+		for (unsigned r = 0; r < program.constants.size(); r++)
+			src << "static const double " << reg(C_REGISTER + 1 + r, 'r') << " = " << literal(program.constants[r].real())
+				<< ", " << reg(C_REGISTER + 1 + r, 'i') << " = " << literal(program.constants[r].imag()) << ";\n";
+
+		// Kernel iterating NATIVE_LANES points at a time, loading the next
+		// point into a lane as soon as its point is done (exactly like the
+		// program kernel, but with the instructions unrolled into one loop
+		// over the lanes, which the compiler is free to vectorise)
+		src << "\nstatic const unsigned LANES = " << NATIVE_LANES << ";\n"
+			<< "\ntemplate <typename Count>\n"
+			<< "static void iterate(const double* zr, const double* zi, const double* cr, const double* ci,\n"
+			<< "\tunsigned count, unsigned maxIter, double tolerance, Count* out,\n"
+			<< "\tunsigned long long* used, unsigned long long* issued)\n"
+			<< "{\n"
+			<< "\tdouble r0r[LANES], r0i[LANES], r1r[LANES], r1i[LANES], sr[LANES], si[LANES];\n"
+			<< "\tunsigned index[LANES], n[LANES];\n"
+			<< "\tbool live[LANES];\n"
+			<< "\tunsigned long long total = 0, steps = 0;\n"
+			<< "\tunsigned next = 0, alive = 0;\n"
+			<< "\tfor (unsigned l = 0; l < LANES; l++)\n"
+			<< "\t{\n"
+			<< "\t\tlive[l] = next < count;\n"
+			<< "\t\tr0r[l] = r0i[l] = r1r[l] = r1i[l] = 0;\n"
+			<< "\t\tif (!live[l]) continue;\n"
+			<< "\t\tindex[l] = next;\n"
+			<< "\t\tr0r[l] = sr[l] = zr[next]; r0i[l] = si[l] = zi[next];\n"
+			<< "\t\tr1r[l] = cr[next]; r1i[l] = ci[next];\n"
+			<< "\t\tn[l] = 0;\n"
+			<< "\t\tnext++;\n"
+			<< "\t\talive++;\n"
+			<< "\t}\n"
+			<< "\twhile (alive > 0)\n"
+			<< "\t{\n"
+			<< "\t\tfor (unsigned l = 0; l < LANES; l++)\n"
+			<< "\t\t{\n";
+		for (vector<Instruction>::const_iterator it = program.code.begin(); it != program.code.end(); ++it)
+			src << "\t\t\t" << statement(*it) << "\n";
+		src << "\t\t\tconst double nr = " << reg(program.result, 'r') << ", ni = " << reg(program.result, 'i') << ";\n"
+			<< "\t\t\tr0r[l] = nr;\n"
+			<< "\t\t\tr0i[l] = ni;\n"
+			<< "\t\t}\n"
+			<< "\t\tsteps += LANES;\n"
+			<< "\t\tfor (unsigned l = 0; l < LANES; l++)\n"
+			<< "\t\t{\n"
+			<< "\t\t\tif (!live[l]) continue;\n"
+			<< "\t\t\tbool escaped = !(r0r[l]*r0r[l] + r0i[l]*r0i[l] < " << literal(BAILOUT) << ");\n"
+			<< "\t\t\tif (!escaped) n[l]++;\n"
+			<< "\t\t\tdouble dx = r0r[l] - sr[l], dy = r0i[l] - si[l];\n"
+			<< "\t\t\tbool cycle = !escaped && dx*dx + dy*dy < tolerance;\n"
+			<< "\t\t\tif (!(n[l] & (n[l] - 1))) { sr[l] = r0r[l]; si[l] = r0i[l]; }\n"
+			<< "\t\t\tif (!escaped && !cycle && n[l] < maxIter) continue;\n"
+			<< "\t\t\tout[index[l]] = cycle ? maxIter : n[l];\n"
+			<< "\t\t\ttotal += escaped ? n[l] + 1 : n[l];\n"
+			<< "\t\t\tif (next < count)\n"
+			<< "\t\t\t{\n"
+			<< "\t\t\t\tindex[l] = next;\n"
+			<< "\t\t\t\tr0r[l] = sr[l] = zr[next]; r0i[l] = si[l] = zi[next];\n"
+			<< "\t\t\t\tr1r[l] = cr[next]; r1i[l] = ci[next];\n"
+			<< "\t\t\t\tn[l] = 0;\n"
+			<< "\t\t\t\tnext++;\n"
+			<< "\t\t\t}\n"
+			<< "\t\t\telse\n"
+			<< "\t\t\t{\n"
+			<< "\t\t\t\tlive[l] = false;\n"
+			<< "\t\t\t\tr0r[l] = r0i[l] = r1r[l] = r1i[l] = 0;\n"
+			<< "\t\t\t\talive--;\n"
+			<< "\t\t\t}\n"
+			<< "\t\t}\n"
+			<< "\t}\n"
+			<< "\t*used   += total;\n"
+			<< "\t*issued += steps;\n"
+			<< "}\n";
+
+		// Kernel of every count width
+		for (unsigned w = 0; w < 3; w++)
+			src << "\nextern \"C\" void " << nativeNames[w] << "(const double* zr, const double* zi, const double* cr, const double* ci,\n"
+				<< "\tunsigned count, unsigned maxIter, double tolerance, " << nativeTypes[w] << "* out,\n"
+				<< "\tunsigned long long* used, unsigned long long* issued)\n"
+				<< "{\n"
+				<< "\titerate(zr, zi, cr, ci, count, maxIter, tolerance, out, used, issued);\n"
+				<< "}\n";
+		return src.str();
+	}
+
+	/**
+	 * Returns the directory native programs are cached in by default
+	 * ($XDG_CACHE_HOME/fractal or ~/.cache/fractal, or empty if there is no
+	 * per-user cache directory, since a shared one would let other users plant
+	 * shared objects)
+	 *
+	 * @return the directory native programs are cached in by default
+	 */
+	string defaultNativeCache()
+	{
+		const char* xdg  = getenv("XDG_CACHE_HOME");
+		const char* home = getenv("HOME");
+		if (xdg && *xdg)   return string(xdg) + "/fractal";
+		if (home && *home) return string(home) + "/.cache/fractal";
+		return "";
+	}
+
+	/**
+	 * Returns the given path quoted for the shell
+	 *
+	 * @param path the path
+	 *
+	 * @return the path quoted for the shell
+	 */
+	static string quote(const string& path)
+	{
+		string quoted = "'";
+		for (unsigned i = 0; i < path.size(); i++)
+			quoted += path[i] == '\'' ? string("'\\''") : string(1, path[i]);
+		return quoted + "'";
+	}
+
+	/**
+	 * Returns the 64-bit FNV-1a hash of the given text, in hexadecimal
+	 *
+	 * @param text the text
+	 *
+	 * @return the hash of the text
+	 */
+	static string hash(const string& text)
+	{
+		unsigned long long h = 14695981039346656037ULL;
+		for (unsigned i = 0; i < text.size(); i++)
+		{
+			h ^= (unsigned char)text[i];
+			h *= 1099511628211ULL;
+		}
+		char buffer[17];
+		snprintf(buffer, sizeof(buffer), "%016llx", h);
+		return buffer;
+	}
+
+	/**
+	 * Creates the given directory (private to this user) and every missing
+	 * directory above it
+	 *
+	 * @param dir the directory
+	 *
+	 * @return true if the directory exists
+	 */
+	static bool makeDirectory(const string& dir)
+	{
+		for (size_t i = dir.find('/', 1); i != string::npos; i = dir.find('/', i + 1))
+			mkdir(dir.substr(0, i).c_str(), 0700);
+		mkdir(dir.c_str(), 0700);
+		struct stat info;
+		return stat(dir.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+	}
+
+	/**
+	 * Returns true if only this user can write to the given directory (anything
+	 * in a directory others can write to may have been planted by them, so it
+	 * is never loaded)
+	 *
+	 * @param dir the directory
+	 *
+	 * @return true if only this user can write to the directory
+	 */
+	static bool privateDirectory(const string& dir)
+	{
+		struct stat info;
+		return stat(dir.c_str(), &info) == 0 && S_ISDIR(info.st_mode)
+			&& info.st_uid == getuid() && !(info.st_mode & (S_IWGRP | S_IWOTH));
+	}
+
+	/**
+	 * Creates a NativeProgram with nothing loaded
+	 */
+	NativeProgram::NativeProgram():
+	m_handle(0)
+	{
+		fill(m_functions, m_functions + 3, (void*)0);
+	}
+
+	/**
+	 * Unloads the program
+	 */
+	NativeProgram::~NativeProgram()
+	{
+		unload();
+	}
+
+	/**
+	 * Loads the given program, building it into the given cache directory
+	 * unless it was built before (if it can not be built or loaded, nothing
+	 * is loaded and the reason is kept)
+	 *
+	 * @param program the program
+	 * @param cache   the directory shared objects are cached in
+	 *
+	 * @return true if the program was loaded
+	 */
+	bool NativeProgram::load(const Program& program, const string& cache)
+	{
+		// Already loaded
+		if (loaded() && m_source == program.source) return true;
+		unload();
+
+		// Shared objects are named after the hash of their source and build command
+		string source  = nativeSource(program);
+		string command = string(NATIVE_COMPILER) + " " + NATIVE_FLAGS;
+		string base    = cache + "/formula-" + hash(command + "\n" + source);
+		string object  = base + ".so";
+		if (cache.empty())
+		{
+			m_error = "no per-user cache directory (set HOME or -jitcache)";
+			return false;
+		}
+		if (!makeDirectory(cache))
+		{
+			m_error = "can not create " + cache;
+			return false;
+		}
+		if (!privateDirectory(cache))
+		{
+			m_error = cache + " is not owned by this user or others can write to it";
+			return false;
+		}
+
+		// Build (unless cached), into a file of this process first so that
+		// other processes never load a half-written shared object
+		bool cached = access(object.c_str(), R_OK) == 0;
+		for (unsigned attempt = 0; attempt < 2; attempt++)
+		{
+			if (!cached)
+			{
+				ostringstream pid;
+				pid << getpid();
+				string temp = base + "." + pid.str();
+				ofstream file((temp + ".cpp").c_str());
+				file << source;
+				file.close();
+				if (!file)
+				{
+					m_error = "can not write " + temp + ".cpp";
+					return false;
+				}
+				string build = command + " -x c++ " + quote(temp + ".cpp") + " -o " + quote(temp + ".so") + " > " + quote(base + ".log") + " 2>&1";
+				bool built = system(build.c_str()) == 0 && rename((temp + ".so").c_str(), object.c_str()) == 0;
+				remove((temp + ".cpp").c_str());
+				if (!built)
+				{
+					remove((temp + ".so").c_str());
+					m_error = string(NATIVE_COMPILER) + " failed (see " + base + ".log)";
+					return false;
+				}
+				remove((base + ".log").c_str());
+			}
+
+			// Load (rebuilding a cached shared object that will not load)
+			m_handle = dlopen(object.c_str(), RTLD_NOW | RTLD_LOCAL);
+			if (m_handle) break;
+			m_error = dlerror();
+			if (!cached) return false;
+			remove(object.c_str());
+			cached = false;
+		}
+
+		// Look up the kernels
+		for (unsigned w = 0; w < 3; w++)
+		{
+			m_functions[w] = dlsym(m_handle, nativeNames[w]);
+			if (!m_functions[w])
+			{
+				m_error = string(nativeNames[w]) + " is missing from " + object;
+				unload();
+				return false;
+			}
+		}
+		m_source = program.source;
+		m_error.clear();
+		return true;
+	}
+
+	/**
+	 * Unloads the program
+	 */
+	void NativeProgram::unload()
+	{
+		if (m_handle) dlclose(m_handle);
+		m_handle = 0;
+		m_source.clear();
+		fill(m_functions, m_functions + 3, (void*)0);
+	}
+
+	/**
+	 * Returns true if a program is loaded
+	 *
+	 * @return true if a program is loaded
+	 */
+	bool NativeProgram::loaded() const
+	{
+		return m_handle != 0;
+	}
+
+	/**
+	 * Returns why the last program could not be loaded
+	 *
+	 * @return why the last program could not be loaded (empty if it was)
+	 */
+	const string& NativeProgram::error() const
+	{
+		return m_error;
+	}
+
+	/**
+	 * Returns the kernel of the given count width
+	 *
+	 * @param width the count width in bytes (1, 2 or 4)
+	 *
+	 * @return the kernel (a NativeKernel function)
+	 */
+	void* NativeProgram::function(unsigned width) const
+	{
+		return m_functions[width == 1 ? 0 : width == 2 ? 1 : 2];
+	}
+}
@@ -0,0 +1,721 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/fractal.h"
+#include "Fractal/bigfloat.h"
+#include "Fractal/threadpool.h"
+
+// Libraries being used
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Namespaces being used
+using namespace std;
+using namespace cimg_library;
+using namespace fractal::colormap;
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	// Points whose squared magnitude falls below this fraction of the squared
+	// magnitude of the reference are glitched (Pauldelbrot's criterion)
+	static const double GLITCH_TOLERANCE = 1e-6;
+
+	// Most reference orbits computed for one image
+	static const unsigned MAX_REFERENCES = 64;
+
+	// Number of pixels iterated by each task
+	static const unsigned TASK_PIXELS = 4096;
+
+	// Number of terms of the series approximation
+	static const unsigned SERIES_TERMS = 8;
+
+	// Number of probe points along the edge of the pixels the series approximates
+	static const unsigned SERIES_PROBES = 16;
+
+	// Largest error of the series approximation at a probe point, as a fraction
+	// of the distance between the orbits of neighbouring pixels (orbits on the
+	// boundary are chaotic, so this is far below what would move a pixel)
+	static const double SERIES_TOLERANCE = 1e-9;
+
+	// True if pixels skip iterations with the series approximation
+	static bool series = true;
+
+	// Largest error of one bilinear step, relative to the step (2^-53, the
+	// precision of a double)
+	static const double BILINEAR_TOLERANCE = 1.1102230246251565e-16;
+
+	// Bilinear steps built for distances of c up to this many times those of an
+	// image are kept for it (so a zoom sequence reuses them from frame to frame)
+	static const double BILINEAR_REUSE = 2;
+
+	// True if pixels take bilinear steps
+	static bool bilinear = true;
+
+	/**
+	 * Many iterations of d = 2zd + d^2 + dc along a reference orbit approximated
+	 * by one bilinear step d = ad + b dc, which holds while d is within its radius
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct BilinearStep
+	{
+		/**
+		 * The coefficient of the distance
+		 */
+		complex<double> a;
+
+		/**
+		 * The coefficient of the distance of c
+		 */
+		complex<double> b;
+
+		/**
+		 * The largest distance the step holds for
+		 */
+		double radius;
+
+		/**
+		 * The number of iterations the step takes
+		 */
+		unsigned length;
+
+		/**
+		 * Creates a BilinearStep with the given parameters
+		 *
+		 * @param a      the coefficient of the distance
+		 * @param b      the coefficient of the distance of c
+		 * @param radius the largest distance the step holds for
+		 * @param length the number of iterations the step takes
+		 */
+		BilinearStep(const complex<double>& a, const complex<double>& b, double radius, unsigned length):
+		a(a), b(b), radius(radius), length(length) {}
+	};
+
+	/**
+	 * The orbit of one point computed to the precision of the image and rounded
+	 * to doubles, which every other point is iterated as a distance from
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct ReferenceOrbit
+	{
+		/**
+		 * The distance of the point from the offset
+		 */
+		complex<double> distance;
+
+		/**
+		 * The real components of the orbit (starting with the point itself)
+		 */
+		vector<double> real;
+
+		/**
+		 * The imaginary components of the orbit (starting with the point itself)
+		 */
+		vector<double> imag;
+
+		/**
+		 * The number of iterations every pixel skips with the series approximation
+		 */
+		unsigned skip;
+
+		/**
+		 * The distance from the point that the series is in units of
+		 */
+		double radius;
+
+		/**
+		 * The coefficients of the series approximating the distance of a pixel's
+		 * orbit from the reference after skip iterations, in powers of its
+		 * distance from the point (in units of radius) from the first up
+		 */
+		complex<double> series[SERIES_TERMS];
+
+		/**
+		 * The bilinear steps of each level, where level k holds the steps of 2^k
+		 * iterations starting at each multiple of 2^k
+		 */
+		vector< vector<BilinearStep> > steps;
+
+		/**
+		 * The largest distance of c the bilinear steps were built for (negative
+		 * if they have not been built)
+		 */
+		double stepRadius;
+
+		/**
+		 * True if the orbit is of the mandelbrot set
+		 */
+		bool mbrot;
+
+		/**
+		 * The julia set complex constant of the orbit
+		 */
+		complex<double> c;
+
+		/**
+		 * The digits of the real component of the offset the orbit is about
+		 */
+		string offsetRealDigits;
+
+		/**
+		 * The digits of the imaginary component of the offset the orbit is about
+		 */
+		string offsetImagDigits;
+
+		/**
+		 * The number of limbs the orbit was computed with
+		 */
+		unsigned limbs;
+
+		/**
+		 * The iteration limit the orbit was computed to
+		 */
+		unsigned maxIter;
+
+		/**
+		 * Creates an empty ReferenceOrbit
+		 */
+		ReferenceOrbit(): skip(0), radius(0), stepRadius(-1), mbrot(false), limbs(0), maxIter(0) {}
+	};
+
+	// The first reference orbit of the last image (at its offset), kept for
+	// the next image about the same point
+	static ReferenceOrbit lastOrbit;
+
+	/**
+	 * Computes the orbit of the point at the given pixel to the precision needed
+	 * to tell neighbouring pixels apart, until it escapes or reaches the iteration limit
+	 *
+	 * @param trans   the image configuration
+	 * @param mbrot   true if the mandelbrot set is being rendered
+	 * @param c       the julia set complex constant
+	 * @param x       the x coord of the pixel
+	 * @param y       the y coord of the pixel
+	 * @param maxIter the iteration limit
+	 * @param orbit   the reference orbit (set)
+	 */
+	static void referenceOrbit(const Transform& trans, bool mbrot, const complex<double>& c,
+		double x, double y, unsigned maxIter, ReferenceOrbit& orbit)
+	{
+		// The point is the offset (read from its digits) plus the distance of the pixel
+		unsigned limbs = bigFloatLimbs(trans.spacing());
+		orbit.distance         = trans.distance(x, y);
+		orbit.mbrot            = mbrot;
+		orbit.c                = c;
+		orbit.offsetRealDigits = trans.offsetRealDigits;
+		orbit.offsetImagDigits = trans.offsetImagDigits;
+		orbit.limbs            = limbs;
+		orbit.maxIter          = maxIter;
+		orbit.stepRadius       = -1;
+		BigFloat pr = BigFloat(trans.offsetRealDigits, limbs) + BigFloat(orbit.distance.real(), limbs);
+		BigFloat pi = BigFloat(trans.offsetImagDigits, limbs) + BigFloat(orbit.distance.imag(), limbs);
+
+		// Julia sets start at the point with a constant c, Mandelbrot sets start at zero with c at the point
+		BigFloat zr = mbrot ? BigFloat(limbs) : pr, zi = mbrot ? BigFloat(limbs) : pi;
+		BigFloat cr = mbrot ? pr : BigFloat(c.real(), limbs), ci = mbrot ? pi : BigFloat(c.imag(), limbs);
+		BigFloat zri(limbs);
+
+		// Iterative process (keeping the point that escapes)
+		orbit.real.assign(1, zr.toDouble());
+		orbit.imag.assign(1, zi.toDouble());
+		for (unsigned n = 0; n < maxIter; n++)
+		{
+			// Iteration function (z = z^2 + c)
+			zri = zr*zi;
+			zr  = zr*zr - zi*zi + cr;
+			zi  = zri + zri + ci;
+			orbit.real.push_back(zr.toDouble());
+			orbit.imag.push_back(zi.toDouble());
+
+			// Break if z goes to infinity (beyond space)
+			if (orbit.real.back()*orbit.real.back() + orbit.imag.back()*orbit.imag.back() >= BAILOUT) break;
+		}
+	}
+
+	/**
+	 * Returns true if the given reference orbit about the offset can be used
+	 * for an image (it is about the same point, and precise and long enough)
+	 *
+	 * @param orbit   the reference orbit
+	 * @param trans   the image configuration
+	 * @param mbrot   true if the mandelbrot set is being rendered
+	 * @param c       the julia set complex constant
+	 * @param maxIter the iteration limit
+	 *
+	 * @return true if the reference orbit can be used for the image
+	 */
+	static bool reusable(const ReferenceOrbit& orbit, const Transform& trans, bool mbrot,
+		const complex<double>& c, unsigned maxIter)
+	{
+		// Orbits that escape are complete at any limit
+		bool escaped = !orbit.real.empty() &&
+			orbit.real.back()*orbit.real.back() + orbit.imag.back()*orbit.imag.back() >= BAILOUT;
+		return orbit.limbs >= bigFloatLimbs(trans.spacing()) && orbit.mbrot == mbrot && (mbrot || orbit.c == c)
+			&& orbit.offsetRealDigits == trans.offsetRealDigits && orbit.offsetImagDigits == trans.offsetImagDigits
+			&& (orbit.maxIter >= maxIter || escaped);
+	}
+
+	/**
+	 * Builds the bilinear steps of the given reference orbit for distances of c
+	 * up to its radius. A single iteration d = 2zd + d^2 + dc is linear while d^2
+	 * is below the precision of 2zd, and each level merges pairs of steps from
+	 * the level below (where the first step must land within the radius of the second).
+	 *
+	 * @param orbit the reference orbit (steps and stepRadius set)
+	 */
+	static void bilinearTable(ReferenceOrbit& orbit)
+	{
+		// Single iterations
+		double dc = orbit.mbrot ? orbit.radius : 0;
+		complex<double> a;
+		vector<BilinearStep> level;
+		for (unsigned n = 0; n + 1 < orbit.real.size(); n++)
+		{
+			a = 2.0*complex<double>(orbit.real[n], orbit.imag[n]);
+			level.push_back(BilinearStep(a, orbit.mbrot ? 1 : 0, BILINEAR_TOLERANCE * abs(a), 1));
+		}
+		orbit.steps.assign(1, level);
+
+		// Merge pairs until one step covers the orbit
+		while (orbit.steps.back().size() > 1)
+		{
+			const vector<BilinearStep>& below = orbit.steps.back();
+			level.clear();
+			for (unsigned m = 0; m + 1 < below.size(); m += 2)
+			{
+				const BilinearStep& x = below[m];
+				const BilinearStep& y = below[m+1];
+				double radius = abs(x.a) > 0 ? max(0.0, (y.radius - abs(x.b)*dc) / abs(x.a)) : 0;
+				level.push_back(BilinearStep(y.a*x.a, y.a*x.b + y.b, min(x.radius, radius), x.length + y.length));
+			}
+			orbit.steps.push_back(level);
+		}
+		orbit.stepRadius = dc;
+	}
+
+	/**
+	 * Returns the longest bilinear step of the given reference orbit starting
+	 * at the given iteration that holds for the given distance
+	 *
+	 * @param orbit the reference orbit
+	 * @param n     the iteration the step starts at
+	 * @param mag   the squared magnitude of the distance
+	 * @param limit the iteration the step must not go beyond
+	 *
+	 * @return the longest bilinear step that holds (null if none of more than one iteration does)
+	 */
+	static inline const BilinearStep* bilinearStep(const ReferenceOrbit& orbit, unsigned n, double mag, unsigned limit)
+	{
+		// Steps of level k start at multiples of 2^k, and each holds for no more
+		// than the one it starts with from the level below, so climb until one fails
+		const BilinearStep* longest = 0;
+		for (unsigned k = 1; k < orbit.steps.size() && !(n & ((1u << k) - 1)); k++)
+		{
+			if ((n >> k) >= orbit.steps[k].size() || n + (1u << k) > limit) break;
+			const BilinearStep& step = orbit.steps[k][n >> k];
+			if (!(mag < step.radius*step.radius)) break;
+			longest = &step;
+		}
+		return longest;
+	}
+
+	/**
+	 * Evaluates the given series approximation
+	 *
+	 * @param series the coefficients of the series (from the first power up)
+	 * @param u      the distance from the point (in units of the radius)
+	 *
+	 * @return the approximate distance of the orbit from the reference after skip iterations
+	 */
+	static complex<double> evaluateSeries(const complex<double>* series, const complex<double>& u)
+	{
+		// Horner's method
+		complex<double> value = series[SERIES_TERMS - 1];
+		for (unsigned k = SERIES_TERMS - 1; k-- > 0;)
+			value = value*u + series[k];
+		return value*u;
+	}
+
+	/**
+	 * Fits a power series in the distance of a pixel from the reference to the
+	 * distance of its orbit from the reference orbit, and finds how many
+	 * iterations it can skip. Probe points on the edge of the pending pixels are
+	 * iterated alongside the series, which stops at the first iteration where a
+	 * probe escapes, glitches or strays from the series by more than
+	 * SERIES_TOLERANCE of the gap between neighbouring pixels (the error of the
+	 * series is analytic, so it is largest on the edge).
+	 *
+	 * @param trans   the image configuration
+	 * @param mbrot   true if the mandelbrot set is being rendered
+	 * @param pending the indices of the pixels being iterated
+	 * @param orbit   the reference orbit (skip, radius and series set)
+	 */
+	static void seriesApproximation(const Transform& trans, bool mbrot, const vector<unsigned>& pending, ReferenceOrbit& orbit)
+	{
+		// Bounding box of the pending pixels
+		unsigned width = trans.size.width;
+		double left = width, right = 0, top = trans.size.height, bottom = 0;
+		for (vector<unsigned>::const_iterator it = pending.begin(); it != pending.end(); ++it)
+		{
+			left   = min<double>(left,   *it % width);
+			right  = max<double>(right,  *it % width);
+			top    = min<double>(top,    *it / width);
+			bottom = max<double>(bottom, *it / width);
+		}
+
+		// Probes spaced evenly around the box (the series is in units of the farthest)
+		vector< complex<double> > delta, dz, dc;
+		double side, along;
+		orbit.skip   = 0;
+		orbit.radius = 0;
+		for (unsigned p = 0; p < SERIES_PROBES; p++)
+		{
+			along = modf(4.0 * p / SERIES_PROBES, &side);
+			complex<double> d =
+				side == 0 ? trans.distance(left + along*(right - left), top) :
+				side == 1 ? trans.distance(right, top + along*(bottom - top)) :
+				side == 2 ? trans.distance(right - along*(right - left), bottom) :
+				            trans.distance(left, bottom - along*(bottom - top));
+			d -= orbit.distance;
+			if (d == 0.0) continue;
+			delta.push_back(d);
+			dz.push_back(mbrot ? 0 : d);
+			dc.push_back(mbrot ? d : 0);
+			orbit.radius = max(orbit.radius, abs(d));
+		}
+		if (!series || delta.empty()) return;
+
+		// Julia sets start at their distance, Mandelbrot sets start at zero
+		complex<double> coeff[SERIES_TERMS], next[SERIES_TERMS], z, w;
+		coeff[0] = mbrot ? 0 : orbit.radius;
+		for (unsigned n = 0; n + 1 < orbit.real.size(); n++)
+		{
+			// Series iteration (the coefficient of each power gains 2z times itself,
+			// the products of each pair of lower powers adding up to it, and dc)
+			z = complex<double>(orbit.real[n], orbit.imag[n]);
+			for (unsigned k = 0; k < SERIES_TERMS; k++)
+			{
+				next[k] = 2.0*z*coeff[k];
+				for (unsigned i = 0; i < k; i++) next[k] += coeff[i]*coeff[k-1-i];
+			}
+			if (mbrot) next[0] += orbit.radius;
+
+			// Probes iterate d = 2zd + d^2 + dc, and must not escape or stray
+			w = complex<double>(orbit.real[n+1], orbit.imag[n+1]);
+			double spread = 0;
+			for (unsigned p = 0; p < delta.size(); p++)
+			{
+				dz[p]  = 2.0*z*dz[p] + dz[p]*dz[p] + dc[p];
+				spread = max(spread, abs(dz[p]));
+				if (norm(w + dz[p]) >= BAILOUT) return;
+				if (abs(evaluateSeries(next, delta[p] / orbit.radius) - dz[p]) >
+					SERIES_TOLERANCE * abs(dz[p]) * trans.spacing() / abs(delta[p])) return;
+			}
+
+			// Pixels can only glitch where their orbits reach zero, which they
+			// must be free to be caught doing (the orbits lie within the probes)
+			if (abs(w) <= spread) return;
+
+			// Every probe agrees, so the series can skip this iteration
+			for (unsigned k = 0; k < SERIES_TERMS; k++)
+				orbit.series[k] = coeff[k] = next[k];
+			orbit.skip = n + 1;
+		}
+	}
+
+	/**
+	 * Iterates a range of pixels as distances from a reference orbit
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	class PerturbTask : public Task
+	{
+	private:
+		/**
+		 * The image configuration
+		 */
+		const Transform& m_trans;
+
+		/**
+		 * The reference orbit
+		 */
+		const ReferenceOrbit& m_orbit;
+
+		/**
+		 * True if the mandelbrot set is being rendered
+		 */
+		bool m_mbrot;
+
+		/**
+		 * The iteration limit
+		 */
+		unsigned m_maxIter;
+
+		/**
+		 * The indices of the pixels to iterate
+		 */
+		const vector<unsigned>& m_pixels;
+
+		/**
+		 * The first pixel to iterate (in m_pixels)
+		 */
+		unsigned m_begin;
+
+		/**
+		 * One past the last pixel to iterate (in m_pixels)
+		 */
+		unsigned m_end;
+
+		/**
+		 * The number of iterations before infinity of each pixel (set)
+		 */
+		vector<unsigned>& m_result;
+
+		/**
+		 * How badly each pixel glitched (set, negative if it did not)
+		 */
+		vector<double>& m_glitch;
+	public:
+		/**
+		 * The lane usage of the task
+		 */
+		KernelStats stats;
+
+		/**
+		 * Creates a PerturbTask with the given parameters
+		 *
+		 * @param trans   the image configuration
+		 * @param orbit   the reference orbit
+		 * @param mbrot   true if the mandelbrot set is being rendered
+		 * @param maxIter the iteration limit
+		 * @param pixels  the indices of the pixels to iterate
+		 * @param begin   the first pixel to iterate (in pixels)
+		 * @param end     one past the last pixel to iterate (in pixels)
+		 * @param result  the number of iterations before infinity of each pixel (set)
+		 * @param glitch  how badly each pixel glitched (set, negative if it did not)
+		 */
+		PerturbTask(const Transform& trans, const ReferenceOrbit& orbit, bool mbrot, unsigned maxIter,
+			const vector<unsigned>& pixels, unsigned begin, unsigned end,
+			vector<unsigned>& result, vector<double>& glitch):
+		m_trans(trans), m_orbit(orbit), m_mbrot(mbrot), m_maxIter(maxIter),
+		m_pixels(pixels), m_begin(begin), m_end(end), m_result(result), m_glitch(glitch) {}
+
+		/**
+		 * Iterates each pixel as its distance d from the reference z, which goes
+		 * d = 2zd + d^2 + dc, and stops it when z + d escapes or is glitched
+		 */
+		void run()
+		{
+			const vector<double>& zr = m_orbit.real;
+			const vector<double>& zi = m_orbit.imag;
+			unsigned length = zr.size(), width = m_trans.size.width;
+			unsigned long long used = 0;
+			for (unsigned k = m_begin; k < m_end; k++)
+			{
+				// Distance of the pixel from the reference (which is the starting
+				// distance of a Julia set, or the distance of c of a Mandelbrot set)
+				unsigned i = m_pixels[k];
+				complex<double> delta = m_trans.distance(i % width, i / width) - m_orbit.distance;
+				double dr  = m_mbrot ? 0 : delta.real(), di  = m_mbrot ? 0 : delta.imag();
+				double dcr = m_mbrot ? delta.real() : 0, dci = m_mbrot ? delta.imag() : 0;
+				double tr, pr, pi, mag;
+				double glitch = -1;
+				unsigned n, skipped = m_orbit.skip;
+				const BilinearStep* step;
+
+				// Skip the iterations the series approximates
+				if (m_orbit.skip)
+				{
+					delta = evaluateSeries(m_orbit.series, delta / m_orbit.radius);
+					dr    = delta.real();
+					di    = delta.imag();
+				}
+
+				// Iterative process
+				for (n = m_orbit.skip; n < m_maxIter; n++)
+				{
+					// Glitched if the reference escaped first (ranked behind true glitches)
+					if (n + 1 >= length) { glitch = 1; break; }
+
+					// Take the longest bilinear step that holds (d = ad + b dc), landing
+					// where one iteration would, or else iterate (d = 2zd + d^2 + dc).
+					// No step holds unless one iteration would, which is checked first.
+					mag  = dr*dr + di*di;
+					step = bilinear && mag < 4*BILINEAR_TOLERANCE*BILINEAR_TOLERANCE * (zr[n]*zr[n] + zi[n]*zi[n])
+						? bilinearStep(m_orbit, n, mag, min(m_maxIter, length - 1)) : 0;
+					if (step)
+					{
+						tr = step->a.real()*dr - step->a.imag()*di + step->b.real()*dcr - step->b.imag()*dci;
+						di = step->a.real()*di + step->a.imag()*dr + step->b.real()*dci + step->b.imag()*dcr;
+						dr = tr;
+						n += step->length - 1;
+						skipped += step->length - 1;
+					}
+					else
+					{
+						tr = 2*(zr[n]*dr - zi[n]*di) + dr*dr - di*di + dcr;
+						di = 2*(zr[n]*di + zi[n]*dr + dr*di) + dci;
+						dr = tr;
+					}
+
+					// Break if z + d goes to infinity (beyond space)
+					pr  = zr[n+1] + dr;
+					pi  = zi[n+1] + di;
+					mag = pr*pr + pi*pi;
+					if (mag >= BAILOUT) break;
+
+					// Break if z + d is far smaller than z (d has lost its precision)
+					tr = zr[n+1]*zr[n+1] + zi[n+1]*zi[n+1];
+					if (mag < GLITCH_TOLERANCE * tr) { glitch = mag / tr; break; }
+				}
+
+				// Escaping points also spend the iteration they stopped on
+				m_result[i] = n;
+				m_glitch[i] = glitch;
+				used += (n < m_maxIter ? n + 1 : n) - skipped;
+				stats.skipped += skipped;
+			}
+
+			// One lane is always busy
+			stats.used   += used;
+			stats.issued += used;
+		}
+	};
+
+	/**
+	 * Sets whether perturbed pixels skip their first iterations with a series approximation
+	 *
+	 * @param enabled true to skip iterations with a series approximation
+	 */
+	void setSeriesApproximation(bool enabled)
+	{
+		series = enabled;
+	}
+
+	/**
+	 * Sets whether perturbed pixels take bilinear steps
+	 *
+	 * @param enabled true to take bilinear steps
+	 */
+	void setBilinearApproximation(bool enabled)
+	{
+		bilinear = enabled;
+	}
+
+	/**
+	 * Generates a Julia or Mandelbrot set image by perturbation, for zooms far
+	 * beyond what a double-double can resolve. One reference orbit is computed
+	 * at the offset to the precision of the image, and every pixel is iterated
+	 * as a double distance from it. Pixels that glitch (Pauldelbrot's criterion,
+	 * or outliving the reference) are iterated again from a reference at the
+	 * worst glitched pixel, until none are left or MAX_REFERENCES is reached.
+	 * Each reference also fits a series approximation that lets every pixel
+	 * skip the iterations it predicts, and a table of bilinear steps that
+	 * lets pixels take many iterations at once. The first reference and its
+	 * table are kept for the next image about the same point.
+	 *
+	 * @param image  the image object to render
+	 * @param trans  the image configuration
+	 * @param map    the colormap being used
+	 * @param mbrot  true if the mandelbrot set is being rendered
+	 * @param c      the julia set complex constant
+	 * @param params the kernel parameters
+	 * @param stats  the lane usage of the kernel (added to if given)
+	 *
+	 * @return total number of iterations that were calculated
+	 */
+	unsigned long long generatePerturbedImage(CImg<char>& image, const Transform& trans, const ColorMapRGB* map,
+		bool mbrot, const complex<double>& c, const KernelParams& params, KernelStats* stats)
+	{
+		// Every pixel starts out pending, with the first reference at the offset
+		unsigned width = image.width(), count = width * image.height();
+		vector<unsigned> result(count), pending(count);
+		vector<double> glitch(count, -1);
+		for (unsigned i = 0; i < count; i++) pending[i] = i;
+		double x = trans.shift.real(), y = trans.shift.imag();
+
+		// Iterate the pending pixels from each reference in turn (the first is
+		// kept for the next image, and reused from the last image if it can be)
+		ReferenceOrbit secondary;
+		KernelStats total;
+		for (; !pending.empty() && total.references < MAX_REFERENCES; total.references++)
+		{
+			// Compute the reference and its series
+			ReferenceOrbit& orbit = total.references ? secondary : lastOrbit;
+			if (total.references || !reusable(orbit, trans, mbrot, c, params.maxIter))
+				referenceOrbit(trans, mbrot, c, x, y, params.maxIter, orbit);
+			else
+				total.reused++;
+			seriesApproximation(trans, mbrot, pending, orbit);
+
+			// Build the bilinear steps unless they hold for distances of c not much larger than these
+			double dc = mbrot ? orbit.radius : 0;
+			if (bilinear && (orbit.stepRadius < dc || orbit.stepRadius > BILINEAR_REUSE * dc))
+				bilinearTable(orbit);
+
+			// Create a task for each range of pixels
+			vector<Task*> tasks;
+			for (unsigned begin = 0; begin < pending.size(); begin += TASK_PIXELS)
+				tasks.push_back(new PerturbTask(trans, orbit, mbrot, params.maxIter, pending,
+					begin, min<unsigned>(begin + TASK_PIXELS, pending.size()), result, glitch));
+
+			// Run tasks
+			getThreadPool().run(tasks);
+
+			// Sum stats and clean up
+			for (vector<Task*>::iterator it = tasks.begin(); it != tasks.end(); ++it)
+			{
+				total += ((PerturbTask*)*it)->stats;
+				delete *it;
+			}
+
+			// Keep the glitched pixels, and put the next reference at the worst one
+			vector<unsigned> glitched;
+			unsigned worst = 0;
+			for (vector<unsigned>::iterator it = pending.begin(); it != pending.end(); ++it)
+			{
+				if (glitch[*it] < 0) continue;
+				if (glitched.empty() || glitch[*it] < glitch[worst]) worst = *it;
+				glitched.push_back(*it);
+			}
+			pending.swap(glitched);
+			x = worst % width;
+			y = worst / width;
+		}
+		total.glitched = pending.size();
+
+		// Set colors and add to total
+		ColorRGB color;
+		unsigned long long iter = 0;
+		for (unsigned i = 0; i < count; i++)
+		{
+			color = map->color(result[i], params.maxIter);
+			image(i % width, i / width, 0) = color.red;
+			image(i % width, i / width, 1) = color.green;
+			image(i % width, i / width, 2) = color.blue;
+			iter += result[i];
+		}
+
+		// Return total
+		if (stats) *stats += total;
+		return iter;
+	}
+}
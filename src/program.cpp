@@ -0,0 +1,403 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/program.h"
+
+// Libraries being used
+#include <cctype>
+#include <cstdlib>
+#include <cmath>
+#include <sstream>
+
+// Namespaces being used
+using namespace std;
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	// Registers of instruction results are numbered from here while
+	// compiling, and moved down after the constants once their count is known
+	static const unsigned RESULT_BASE = 128;
+
+	/**
+	 * A value of a formula while compiling, either a constant or a register
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	struct FormulaValue
+	{
+		/**
+		 * True if the value is known while compiling
+		 */
+		bool constant;
+
+		/**
+		 * The value (if constant)
+		 */
+		complex<double> value;
+
+		/**
+		 * The register holding the value (if not constant)
+		 */
+		unsigned reg;
+
+		/**
+		 * Creates a constant FormulaValue
+		 *
+		 * @param v the value
+		 */
+		FormulaValue(const complex<double>& v): constant(true), value(v), reg(0) {}
+
+		/**
+		 * Creates a FormulaValue held in the given register
+		 *
+		 * @param r the register
+		 */
+		FormulaValue(unsigned r): constant(false), value(0), reg(r) {}
+	};
+
+	/**
+	 * Compiles a formula into a Program by recursive descent, folding
+	 * constant parts of it
+	 *
+	 * @author  Anshul Kharbanda
+	 * @created 10 - 17 - 2026
+	 */
+	class FormulaCompiler
+	{
+	private:
+		/**
+		 * The program being compiled
+		 */
+		Program& m_program;
+
+		/**
+		 * The formula
+		 */
+		const string& m_source;
+
+		/**
+		 * The position of the next character of the formula
+		 */
+		unsigned m_pos;
+	public:
+		/**
+		 * Creates a FormulaCompiler for the given program
+		 *
+		 * @param program the program being compiled
+		 */
+		FormulaCompiler(Program& program):
+		m_program(program), m_source(program.source), m_pos(0) {}
+
+		/**
+		 * Compiles the formula into the program
+		 *
+		 * @throw Error when the formula can not be parsed or uses too many registers
+		 */
+		void compile() throw(Error)
+		{
+			// The whole formula is one expression
+			FormulaValue result = expression();
+			skipSpace();
+			if (m_pos < m_source.size()) fail("unexpected '" + string(1, m_source[m_pos]) + "'");
+			m_program.result = hold(result);
+
+			// Move result registers down after the constants
+			unsigned base = C_REGISTER + 1 + m_program.constants.size();
+			for (vector<Instruction>::iterator it = m_program.code.begin(); it != m_program.code.end(); ++it)
+			{
+				it->dst = move(it->dst, base);
+				it->a   = move(it->a,   base);
+				it->b   = move(it->b,   base);
+			}
+			m_program.result    = move(m_program.result, base);
+			m_program.registers = base + m_program.code.size();
+			if (m_program.registers > MAX_REGISTERS) fail("it needs more than " + number(MAX_REGISTERS) + " registers");
+		}
+	private:
+		/**
+		 * Throws an Error about the formula
+		 *
+		 * @param reason what is wrong with the formula
+		 *
+		 * @throw Error always
+		 */
+		void fail(const string& reason) throw(Error)
+		{
+			throw Error("Invalid formula: " + m_source + " (" + reason + " at character " + number(m_pos + 1) + ")");
+		}
+
+		/**
+		 * Returns the given number as a string
+		 *
+		 * @param n the number
+		 *
+		 * @return the number as a string
+		 */
+		static string number(unsigned n)
+		{
+			ostringstream str;
+			str << n;
+			return str.str();
+		}
+
+		/**
+		 * Returns the final number of the given register
+		 *
+		 * @param r    the register
+		 * @param base the first result register
+		 *
+		 * @return the final number of the register
+		 */
+		static unsigned char move(unsigned r, unsigned base)
+		{
+			return r >= RESULT_BASE ? r - RESULT_BASE + base : r;
+		}
+
+		/**
+		 * Skips spaces in the formula
+		 */
+		void skipSpace()
+		{
+			while (m_pos < m_source.size() && isspace(m_source[m_pos])) m_pos++;
+		}
+
+		/**
+		 * Skips spaces, then consumes the given character if it is next
+		 *
+		 * @param ch the character
+		 *
+		 * @return true if the character was consumed
+		 */
+		bool accept(char ch)
+		{
+			skipSpace();
+			if (m_pos < m_source.size() && m_source[m_pos] == ch) { m_pos++; return true; }
+			return false;
+		}
+
+		/**
+		 * Returns the register holding the given value (giving constants a
+		 * register of their own, shared by equal constants)
+		 *
+		 * @param v the value
+		 *
+		 * @return the register holding the value
+		 */
+		unsigned hold(const FormulaValue& v)
+		{
+			if (!v.constant) return v.reg;
+			for (unsigned i = 0; i < m_program.constants.size(); i++)
+				if (m_program.constants[i] == v.value) return C_REGISTER + 1 + i;
+			if (m_program.constants.size() >= MAX_REGISTERS) fail("it needs more than " + number(MAX_REGISTERS) + " registers");
+			m_program.constants.push_back(v.value);
+			return C_REGISTER + m_program.constants.size();
+		}
+
+		/**
+		 * Returns the result of the given operation (folded if every operand
+		 * is constant, otherwise emitted as an instruction)
+		 *
+		 * @param op the operation
+		 * @param a  the first operand
+		 * @param b  the second operand (ignored by one-operand operations)
+		 *
+		 * @return the result of the operation
+		 */
+		FormulaValue emit(Opcode op, const FormulaValue& a, const FormulaValue& b)
+		{
+			// Fold constants
+			bool unary = op >= SQUARE_OPCODE;
+			if (a.constant && (unary || b.constant))
+			{
+				switch (op)
+				{
+					case ADD_OPCODE:    return FormulaValue(a.value + b.value);
+					case SUB_OPCODE:    return FormulaValue(a.value - b.value);
+					case MUL_OPCODE:    return FormulaValue(a.value * b.value);
+					case DIV_OPCODE:    return FormulaValue(a.value / b.value);
+					case SQUARE_OPCODE: return FormulaValue(a.value * a.value);
+					case NEG_OPCODE:    return FormulaValue(-a.value);
+					case CONJ_OPCODE:   return FormulaValue(conj(a.value));
+					case REAL_OPCODE:   return FormulaValue(complex<double>(a.value.real()));
+					default:            return FormulaValue(complex<double>(a.value.imag()));
+				}
+			}
+
+			// Emit instruction writing a new register
+			Instruction ins;
+			ins.op  = op;
+			ins.a   = hold(a);
+			ins.b   = unary ? ins.a : hold(b);
+			ins.dst = RESULT_BASE + m_program.code.size();
+			if (m_program.code.size() >= MAX_REGISTERS) fail("it needs more than " + number(MAX_REGISTERS) + " registers");
+			m_program.code.push_back(ins);
+			return FormulaValue(ins.dst);
+		}
+
+		/**
+		 * Compiles a sum or difference of terms
+		 *
+		 * @return the value of the expression
+		 */
+		FormulaValue expression()
+		{
+			FormulaValue v = term();
+			while (true)
+			{
+				if      (accept('+')) v = emit(ADD_OPCODE, v, term());
+				else if (accept('-')) v = emit(SUB_OPCODE, v, term());
+				else return v;
+			}
+		}
+
+		/**
+		 * Compiles a product or quotient of factors
+		 *
+		 * @return the value of the term
+		 */
+		FormulaValue term()
+		{
+			FormulaValue v = factor();
+			while (true)
+			{
+				if      (accept('*')) v = emit(MUL_OPCODE, v, factor());
+				else if (accept('/')) v = emit(DIV_OPCODE, v, factor());
+				else return v;
+			}
+		}
+
+		/**
+		 * Compiles a signed power
+		 *
+		 * @return the value of the factor
+		 */
+		FormulaValue factor()
+		{
+			if (accept('-')) return emit(NEG_OPCODE, factor(), FormulaValue(0u));
+			if (accept('+')) return factor();
+			return power();
+		}
+
+		/**
+		 * Compiles a primary raised to a whole power, by squaring and
+		 * multiplying (negative powers divide one by the power)
+		 *
+		 * @return the value of the power
+		 */
+		FormulaValue power()
+		{
+			FormulaValue base = primary();
+			if (!accept('^')) return base;
+
+			// The power must be a whole constant
+			unsigned at = m_pos;
+			FormulaValue exponent = factor();
+			double n = exponent.value.real();
+			if (!exponent.constant || exponent.value.imag() != 0 || n != floor(n) || fabs(n) > MAX_PROGRAM_POWER)
+			{
+				m_pos = at;
+				fail("powers must be whole numbers up to " + number(MAX_PROGRAM_POWER));
+			}
+
+			// Square and multiply
+			unsigned k = (unsigned)fabs(n);
+			FormulaValue result(complex<double>(1));
+			bool first = true;
+			while (k)
+			{
+				if (k & 1) { result = first ? base : emit(MUL_OPCODE, result, base); first = false; }
+				k >>= 1;
+				if (k) base = emit(SQUARE_OPCODE, base, base);
+			}
+			return n < 0 ? emit(DIV_OPCODE, FormulaValue(complex<double>(1)), result) : result;
+		}
+
+		/**
+		 * Compiles a number, variable, parenthesised expression or function call
+		 *
+		 * @return the value of the primary
+		 */
+		FormulaValue primary()
+		{
+			skipSpace();
+			if (m_pos >= m_source.size()) fail("unexpected end");
+
+			// Parenthesised expression
+			if (accept('('))
+			{
+				FormulaValue v = expression();
+				if (!accept(')')) fail("expected ')'");
+				return v;
+			}
+
+			// Number (imaginary if followed by i)
+			char ch = m_source[m_pos];
+			if (isdigit(ch) || ch == '.')
+			{
+				const char* start = m_source.c_str() + m_pos;
+				char* end;
+				double x = strtod(start, &end);
+				if (end == start) fail("expected a number");
+				m_pos += end - start;
+				if (m_pos < m_source.size() && m_source[m_pos] == 'i') { m_pos++; return FormulaValue(complex<double>(0, x)); }
+				return FormulaValue(complex<double>(x));
+			}
+
+			// Name
+			unsigned at = m_pos;
+			while (m_pos < m_source.size() && isalpha(m_source[m_pos])) m_pos++;
+			string name = m_source.substr(at, m_pos - at);
+			if (name == "z") return FormulaValue(Z_REGISTER);
+			if (name == "c") return FormulaValue(C_REGISTER);
+			if (name == "i") return FormulaValue(complex<double>(0, 1));
+
+			// Function call
+			Opcode op;
+			if      (name == "conj") op = CONJ_OPCODE;
+			else if (name == "re")   op = REAL_OPCODE;
+			else if (name == "im")   op = IMAG_OPCODE;
+			else
+			{
+				m_pos = at;
+				fail(name.empty() ? "unexpected '" + string(1, ch) + "'" : "unknown name '" + name + "'");
+			}
+			if (!accept('(')) fail("expected '('");
+			FormulaValue v = expression();
+			if (!accept(')')) fail("expected ')'");
+			return emit(op, v, v);
+		}
+	};
+
+	/**
+	 * Creates an empty program (z = z)
+	 */
+	Program::Program():
+	registers(C_REGISTER + 1), result(Z_REGISTER) {}
+
+	/**
+	 * Compiles the given formula
+	 *
+	 * @param formula the iteration function of z and c
+	 *
+	 * @throw Error when the formula can not be parsed or uses too many registers
+	 */
+	Program::Program(const string& formula) throw(Error):
+	source(formula), registers(C_REGISTER + 1), result(Z_REGISTER)
+	{
+		FormulaCompiler(*this).compile();
+	}
+}
@@ -0,0 +1,245 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/threadpool.h"
+
+// Libraries being used
+#include <unistd.h>
+
+// Namespaces being used
+using namespace std;
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	// The shared pool
+	static ThreadPool* shared = 0;
+
+	/**
+	 * Destroys the Task
+	 */
+	Task::~Task() {}
+
+	/**
+	 * Creates a ThreadPool with the given number of threads
+	 *
+	 * @param threads the number of threads (all cores if 0)
+	 */
+	ThreadPool::ThreadPool(unsigned threads):
+	m_generation(0), m_pending(0), m_stop(false)
+	{
+		// Default to all cores
+		if (threads == 0) threads = coreCount();
+
+		// Initialize pool state
+		pthread_mutex_init(&m_lock, 0);
+		pthread_cond_init(&m_wake, 0);
+		pthread_cond_init(&m_done, 0);
+
+		// Create workers
+		for (unsigned i = 0; i < threads; i++)
+		{
+			Worker* worker = new Worker();
+			worker->pool  = this;
+			worker->index = i;
+			pthread_mutex_init(&worker->lock, 0);
+			m_workers.push_back(worker);
+		}
+
+		// Start threads (after every queue exists, since workers steal)
+		for (unsigned i = 0; i < threads; i++)
+			pthread_create(&m_workers[i]->thread, 0, work, m_workers[i]);
+	}
+
+	/**
+	 * Stops and joins all of the threads
+	 */
+	ThreadPool::~ThreadPool()
+	{
+		// Tell workers to stop
+		pthread_mutex_lock(&m_lock);
+		m_stop = true;
+		pthread_cond_broadcast(&m_wake);
+		pthread_mutex_unlock(&m_lock);
+
+		// Join and destroy workers
+		for (unsigned i = 0; i < m_workers.size(); i++)
+		{
+			pthread_join(m_workers[i]->thread, 0);
+			pthread_mutex_destroy(&m_workers[i]->lock);
+			delete m_workers[i];
+		}
+
+		// Destroy pool state
+		pthread_cond_destroy(&m_done);
+		pthread_cond_destroy(&m_wake);
+		pthread_mutex_destroy(&m_lock);
+	}
+
+	/**
+	 * Returns the number of threads in the pool
+	 *
+	 * @return the number of threads in the pool
+	 */
+	unsigned ThreadPool::size() const
+	{
+		return m_workers.size();
+	}
+
+	/**
+	 * Runs all of the given tasks, returning once every one is finished
+	 *
+	 * @param tasks the tasks to run
+	 */
+	void ThreadPool::run(const vector<Task*>& tasks)
+	{
+		// Nothing to do
+		if (tasks.empty()) return;
+
+		// Count the batch before any task can be taken (a worker still draining
+		// the queues from the last batch may take one as soon as it is dealt)
+		pthread_mutex_lock(&m_lock);
+		m_pending = tasks.size();
+		pthread_mutex_unlock(&m_lock);
+
+		// Deal tasks out in contiguous blocks so neighbouring tiles share a worker
+		unsigned count = m_workers.size();
+		for (unsigned i = 0; i < tasks.size(); i++)
+		{
+			Worker* worker = m_workers[i * count / tasks.size()];
+			pthread_mutex_lock(&worker->lock);
+			worker->queue.push_front(tasks[i]);
+			pthread_mutex_unlock(&worker->lock);
+		}
+
+		// Post batch and wait for it to finish
+		pthread_mutex_lock(&m_lock);
+		m_generation++;
+		pthread_cond_broadcast(&m_wake);
+		while (m_pending > 0)
+			pthread_cond_wait(&m_done, &m_lock);
+		pthread_mutex_unlock(&m_lock);
+	}
+
+	/**
+	 * Returns the next task for the given worker (0 if none are left)
+	 *
+	 * @param index the index of the worker
+	 *
+	 * @return the next task for the given worker
+	 */
+	Task* ThreadPool::next(unsigned index)
+	{
+		Task* task = 0;
+
+		// Take from the back of our own queue
+		Worker* self = m_workers[index];
+		pthread_mutex_lock(&self->lock);
+		if (!self->queue.empty())
+		{
+			task = self->queue.back();
+			self->queue.pop_back();
+		}
+		pthread_mutex_unlock(&self->lock);
+
+		// Steal from the front of the other queues
+		for (unsigned i = 1; !task && i < m_workers.size(); i++)
+		{
+			Worker* victim = m_workers[(index + i) % m_workers.size()];
+			pthread_mutex_lock(&victim->lock);
+			if (!victim->queue.empty())
+			{
+				task = victim->queue.front();
+				victim->queue.pop_front();
+			}
+			pthread_mutex_unlock(&victim->lock);
+		}
+
+		// Return task
+		return task;
+	}
+
+	/**
+	 * The main loop of a worker thread
+	 *
+	 * @param arg the worker
+	 */
+	void* ThreadPool::work(void* arg)
+	{
+		Worker* worker = (Worker*)arg;
+		ThreadPool* pool = worker->pool;
+		unsigned seen = 0;
+
+		for (;;)
+		{
+			// Sleep until a new batch is posted (or the pool stops)
+			pthread_mutex_lock(&pool->m_lock);
+			while (pool->m_generation == seen && !pool->m_stop)
+				pthread_cond_wait(&pool->m_wake, &pool->m_lock);
+			seen = pool->m_generation;
+			bool stop = pool->m_stop;
+			pthread_mutex_unlock(&pool->m_lock);
+			if (stop) return 0;
+
+			// Run tasks until every queue is empty
+			Task* task;
+			while ((task = pool->next(worker->index)))
+			{
+				task->run();
+
+				// Wake the poster when the last task finishes
+				if (__sync_sub_and_fetch(&pool->m_pending, 1) == 0)
+				{
+					pthread_mutex_lock(&pool->m_lock);
+					pthread_cond_broadcast(&pool->m_done);
+					pthread_mutex_unlock(&pool->m_lock);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Returns the number of available processor cores
+	 *
+	 * @return the number of available processor cores
+	 */
+	unsigned coreCount()
+	{
+		long cores = sysconf(_SC_NPROCESSORS_ONLN);
+		return cores > 0 ? cores : 1;
+	}
+
+	/**
+	 * Creates the shared ThreadPool with the given number of threads
+	 *
+	 * @param threads the number of threads (all cores if 0)
+	 */
+	void initThreadPool(unsigned threads)
+	{
+		delete shared;
+		shared = new ThreadPool(threads);
+	}
+
+	/**
+	 * Returns the shared ThreadPool (created with all cores if not initialized)
+	 *
+	 * @return the shared ThreadPool
+	 */
+	ThreadPool& getThreadPool()
+	{
+		if (!shared) initThreadPool(0);
+		return *shared;
+	}
+}
@@ -0,0 +1,83 @@
+//-----------------------------------------------------------------------------------
+// Program: Fractal
+//
+// Generates Julia and Mandelbrot Set fractal images
+//
+// Author:  Anshul Kharbanda
+// Created: 8 - 14 - 2016
+//-----------------------------------------------------------------------------------
+
+// Headers being used
+#include "Fractal/tile.h"
+
+// Libraries being used
+#include <algorithm>
+
+// Namespaces being used
+using namespace std;
+
+/**
+ * Contains functions and structs used by Fractal generator
+ *
+ * @author  Anshul Kharbanda
+ * @created 8 - 17 - 2016
+ */
+namespace fractal
+{
+	/**
+	 * Creates an empty Tile
+	 */
+	Tile::Tile(): x(0), y(0), width(0), height(0) {}
+
+	/**
+	 * Creates a Tile with the given location and size
+	 *
+	 * @param x the x coord of the top left pixel
+	 * @param y the y coord of the top left pixel
+	 * @param w the width of the tile
+	 * @param h the height of the tile
+	 */
+	Tile::Tile(unsigned x, unsigned y, unsigned w, unsigned h):
+	x(x), y(y), width(w), height(h) {}
+
+	/**
+	 * Returns the area of the tile
+	 *
+	 * @return the area of the tile
+	 */
+	unsigned Tile::area() const
+	{
+		return width*height;
+	}
+
+	/**
+	 * Splits an image of the given size into tiles (row-major order)
+	 *
+	 * @param width  the width of the image
+	 * @param height the height of the image
+	 * @param size   the width and height of each tile
+	 *
+	 * @return the tiles covering the image
+	 */
+	vector<Tile> splitTiles(unsigned width, unsigned height, unsigned size)
+	{
+		return splitTiles(Tile(0, 0, width, height), size);
+	}
+
+	/**
+	 * Splits the given region of an image into tiles (row-major order)
+	 *
+	 * @param region the region of the image
+	 * @param size   the width and height of each tile
+	 *
+	 * @return the tiles covering the region
+	 */
+	vector<Tile> splitTiles(const Tile& region, unsigned size)
+	{
+		vector<Tile> tiles;
+		for (unsigned y = 0; y < region.height; y += size)
+			for (unsigned x = 0; x < region.width; x += size)
+				tiles.push_back(Tile(region.x + x, region.y + y, min(size, region.width - x), min(size, region.height - y)));
+		return tiles;
+	}
+}
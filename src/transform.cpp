@@ -40,6 +40,24 @@ namespace fractal
 			: complex<double>(0,0);
 	}
 	
+	/**
+	 * Returns the rotation complex of the given angle (exact for quarter
+	 * turns, so that rotated images keep the symmetries of the plane)
+	 *
+	 * @param angle the angle of rotation (in degrees)
+	 *
+	 * @return the rotation complex of the given angle
+	 */
+	static complex<double> rotationOf(double angle)
+	{
+		static const complex<double> quarters[] = {
+			complex<double>(1, 0), complex<double>(0, 1), complex<double>(-1, 0), complex<double>(0, -1)
+		};
+		if (fmod(angle, 90) == 0)
+			return quarters[((long)(angle / 90) % 4 + 4) % 4];
+		return polar(1.0, angle * M_PI / 180);
+	}
+
 	/**
 	 * Creates an empty ImgSize
 	 */
@@ -89,6 +107,9 @@ namespace fractal
 	size(ImgSize()),
 	zoom(DEFAULT_ZOOM),
 	offset(DEFAULT_OFFSET),
+	offsetReal(DEFAULT_OFFSET.real()), offsetImag(DEFAULT_OFFSET.imag()),
+	offsetRealFixed(DEFAULT_OFFSET.real()), offsetImagFixed(DEFAULT_OFFSET.imag()),
+	offsetRealDigits("0"), offsetImagDigits("0"),
 	shift(0.5,0.5),
 	rotation(1.0,DEFAULT_ANGLE) {}
 
@@ -101,6 +122,9 @@ namespace fractal
 	size(s),
 	zoom(DEFAULT_ZOOM),
 	offset(DEFAULT_OFFSET),
+	offsetReal(DEFAULT_OFFSET.real()), offsetImag(DEFAULT_OFFSET.imag()),
+	offsetRealFixed(DEFAULT_OFFSET.real()), offsetImagFixed(DEFAULT_OFFSET.imag()),
+	offsetRealDigits("0"), offsetImagDigits("0"),
 	shift(0.5*s.width,0.5*s.height),
 	rotation(1.0,0) {}
 
@@ -109,15 +133,20 @@ namespace fractal
 	 *
 	 * @param s the size of the image
 	 * @param z the zoom scale of the image
-	 * @param x the x offset of the image
-	 * @param y the y offset of the image
+	 * @param x the x offset of the image (as a decimal string)
+	 * @param y the y offset of the image (as a decimal string)
 	 * @param a the rotation angle of the image
 	 */
-	Transform::Transform(ImgSize s, double z, double x, double y, double a):
+	Transform::Transform(ImgSize s, double z, const string& x, const string& y, double a):
 	size(s),
-	zoom(z), offset(x, y),
+	zoom(z), offsetReal(parseDDouble(x)), offsetImag(parseDDouble(y)),
+	offsetRealFixed(parseFixed(x)), offsetImagFixed(parseFixed(y)),
+	offsetRealDigits(x), offsetImagDigits(y),
 	shift(0.5*s.width, 0.5*s.height),
-	rotation(polar(1.0, a * M_PI / 180)) {}
+	rotation(rotationOf(a))
+	{
+		offset = complex<double>(offsetReal.hi, offsetImag.hi);
+	}
 
 	/**
 	 * Creates a transform with the given s and xml
@@ -128,9 +157,15 @@ namespace fractal
 	Transform::Transform(ImgSize s, pugi::xml_node xml):
 	size(s), shift(0.5*size.width, 0.5*size.height)
 	{
-		zoom     = xml.attribute("zoom").as_double(DEFAULT_ZOOM);
-		offset   = rectFromXML(xml.child("offset"));
-		rotation = polar(1.0, xml.attribute("angle").as_double(0) * M_PI / 180);
+		zoom             = xml.attribute("zoom").as_double(DEFAULT_ZOOM);
+		offsetRealDigits = xml.child("offset").attribute("real").as_string("0");
+		offsetImagDigits = xml.child("offset").attribute("imag").as_string("0");
+		offsetReal       = parseDDouble(offsetRealDigits);
+		offsetImag       = parseDDouble(offsetImagDigits);
+		offsetRealFixed  = parseFixed(offsetRealDigits);
+		offsetImagFixed  = parseFixed(offsetImagDigits);
+		offset           = complex<double>(offsetReal.hi, offsetImag.hi);
+		rotation         = rotationOf(xml.attribute("angle").as_double(0));
 	}
 
 	/**
@@ -140,8 +175,34 @@ namespace fractal
 	 */
 	Transform::Transform(const Transform& other):
 	size(other.size), zoom(other.zoom), offset(other.offset),
+	offsetReal(other.offsetReal), offsetImag(other.offsetImag),
+	offsetRealFixed(other.offsetRealFixed), offsetImagFixed(other.offsetImagFixed),
+	offsetRealDigits(other.offsetRealDigits), offsetImagDigits(other.offsetImagDigits),
 	shift(other.shift), rotation(other.rotation) {}
 
+	/**
+	 * Returns the distance in the complex plane between neighbouring pixels
+	 *
+	 * @return the distance between neighbouring pixels
+	 */
+	double Transform::spacing() const
+	{
+		return SCALE / size.height / zoom;
+	}
+
+	/**
+	 * Returns the distance in the complex plane of the given pixel from the offset
+	 *
+	 * @param x the x coord of the pixel
+	 * @param y the y coord of the pixel
+	 *
+	 * @return the distance of the given pixel from the offset
+	 */
+	complex<double> Transform::distance(const double& x, const double& y) const
+	{
+		return spacing() * (complex<double>(x,y) - shift) * rotation;
+	}
+
 	/**
 	 * Returns the complex number mapped at the given pixel by the transform
 	 *
@@ -150,8 +211,42 @@ namespace fractal
 	 *
 	 * @return the complex number mapped at the given pixel by the transform
 	 */
-	complex<double> Transform::operator()(const double& x, const double& y)
+	complex<double> Transform::operator()(const double& x, const double& y) const
+	{
+		return distance(x, y) + offset;
+	}
+
+	/**
+	 * Maps the given pixel to the complex plane in double-double, so that
+	 * neighbouring pixels stay apart far beyond a zoom of 1e13
+	 *
+	 * @param x    the x coord of the pixel
+	 * @param y    the y coord of the pixel
+	 * @param real the real component mapped at the pixel (set)
+	 * @param imag the imaginary component mapped at the pixel (set)
+	 */
+	void Transform::map(const double& x, const double& y, ddouble& real, ddouble& imag) const
+	{
+		// The distance from the offset is small, so it only needs a double
+		complex<double> delta = distance(x, y);
+		real = offsetReal + ddouble(delta.real());
+		imag = offsetImag + ddouble(delta.imag());
+	}
+
+	/**
+	 * Maps the given pixel to the complex plane in 128-bit fixed point, so
+	 * that every machine maps it to exactly the same point
+	 *
+	 * @param x    the x coord of the pixel
+	 * @param y    the y coord of the pixel
+	 * @param real the real component mapped at the pixel (set)
+	 * @param imag the imaginary component mapped at the pixel (set)
+	 */
+	void Transform::map(const double& x, const double& y, fixed128& real, fixed128& imag) const
 	{
-		return (SCALE / size.height / zoom) * (complex<double>(x,y) - shift) * rotation + offset;
+		// The distance from the offset is small, so it only needs a double
+		complex<double> delta = distance(x, y);
+		real = offsetRealFixed + fixed128(delta.real());
+		imag = offsetImagFixed + fixed128(delta.imag());
 	}
 }
\ No newline at end of file